@@ -15,6 +15,7 @@
 #include "vcml/core/version.h"
 #include "vcml/core/thctl.h"
 #include "vcml/core/systemc.h"
+#include "vcml/core/checkpoint.h"
 #include "vcml/core/range.h"
 #include "vcml/core/command.h"
 #include "vcml/core/module.h"
@@ -76,6 +77,7 @@
 #include "vcml/models/generic/gpio.h"
 #include "vcml/models/generic/hwrng.h"
 #include "vcml/models/generic/fbdev.h"
+#include "vcml/models/generic/adaptive_quantum.h"
 
 #include "vcml/models/serial/backend.h"
 #include "vcml/models/serial/terminal.h"
@@ -0,0 +1,97 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef VCML_CHECKPOINT_H
+#define VCML_CHECKPOINT_H
+
+#include "vcml/core/types.h"
+#include "vcml/core/systemc.h"
+
+namespace vcml {
+
+// Streams the state of all modules into one named section per module. Files
+// start with a magic string and a format version followed by the simulation
+// time of the checkpoint and all sections; values use host byte order.
+class checkpoint
+{
+private:
+    struct section {
+        u64 offset;
+        u64 size;
+    };
+
+    bool m_restoring;
+    sc_time m_time;
+    fstream m_file;
+    std::map<string, section> m_sections;
+    section* m_section;
+    u64 m_pos;
+
+    void finish_section();
+
+    void capture(sc_object* obj);
+    void apply(sc_object* obj);
+
+public:
+    static constexpr const char* MAGIC = "VCMLCKPT";
+    static constexpr u32 VERSION = 2;
+
+    bool is_saving() const { return !m_restoring; }
+    bool is_restoring() const { return m_restoring; }
+
+    const sc_time& time() const { return m_time; }
+    size_t num_sections() const { return m_sections.size(); }
+    bool has_section(const string& name) const;
+
+    // bytes left in the current section while restoring
+    u64 remaining() const;
+
+    checkpoint(bool restoring);
+    virtual ~checkpoint() = default;
+
+    checkpoint() = delete;
+    checkpoint(const checkpoint&) = delete;
+
+    bool enter(const string& section);
+
+    void data(void* ptr, size_t size);
+    void value(string& str);
+
+    template <typename T>
+    void value(T& val);
+
+    template <typename T>
+    void value(vector<T>& vec);
+
+    void write(const string& filename);
+    void read(const string& filename);
+    void apply();
+};
+
+template <typename T>
+inline void checkpoint::value(T& val) {
+    static_assert(std::is_trivially_copyable<T>::value, "unsupported type");
+    data(&val, sizeof(val));
+}
+
+template <typename T>
+inline void checkpoint::value(vector<T>& vec) {
+    u64 n = vec.size();
+    value(n);
+    VCML_ERROR_ON(is_restoring() && n > remaining(),
+                  "checkpoint vector length %llu out of bounds", n);
+    vec.resize(n);
+    for (T& elem : vec)
+        value(elem);
+}
+
+} // namespace vcml
+
+#endif
@@ -53,6 +53,8 @@ public:
     virtual void session_suspend();
     virtual void session_resume();
 
+    virtual void serialize(checkpoint& cp);
+
     bool execute(const string& name, ostream& os);
     bool execute(const string& name, const vector<string>& args, ostream& os);
 
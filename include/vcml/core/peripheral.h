@@ -30,8 +30,13 @@ class peripheral : public component
 private:
     int m_current_cpu;
     vector<reg_base*> m_registers;
+    unordered_map<address_space, vector<reg_base*>> m_regmap;
 
     bool cmd_mmap(const vector<string>& args, ostream& os);
+    bool cmd_regstats(const vector<string>& args, ostream& os);
+
+    unsigned int transport_streaming(tlm_generic_payload& tx,
+                                     const tlm_sbi& info, address_space as);
 
 public:
     property<endianess> endian;
@@ -39,6 +44,8 @@ public:
     property<unsigned int> read_latency;
     property<unsigned int> write_latency;
 
+    property<bool> profile_registers;
+
     sc_time read_cycles() const { return clock_cycles(read_latency); }
     sc_time write_cycles() const { return clock_cycles(write_latency); }
 
@@ -59,6 +66,12 @@ public:
 
     void natural_accesses_only(bool only = true);
 
+    bool is_profiling_registers() const { return profile_registers; }
+    void reset_regstats();
+    void write_regstats_csv(ostream& os) const;
+
+    static void export_regstats(ostream& os);
+
     peripheral(const sc_module_name& nm, endianess e = host_endian(),
                unsigned int read_latency = 0, unsigned int write_latency = 0);
     virtual ~peripheral();
@@ -85,6 +98,8 @@ public:
     virtual unsigned int receive(tlm_generic_payload& tx, const tlm_sbi& info,
                                  address_space as);
 
+    virtual bool is_memory_like(const range& addr, address_space as) const;
+
     virtual tlm_response_status read(const range& addr, void* data,
                                      const tlm_sbi& info, address_space);
     virtual tlm_response_status read(const range& addr, void* data,
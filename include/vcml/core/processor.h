@@ -41,6 +41,11 @@ private:
     double m_run_time;
     u64 m_cycle_count;
 
+    bool m_idle;
+    u64 m_idle_skips;
+    sc_time m_idle_time;
+    sc_event m_wakeup;
+
     debugging::gdbserver* m_gdb;
 
     unordered_map<size_t, irq_stats> m_irq_stats;
@@ -55,15 +60,20 @@ private:
     bool cmd_stack(const vector<string>& args, ostream& os);
     bool cmd_gdb(const vector<string>& args, ostream& os);
 
+    u64 access_pmem_dbg(tlm_command cmd, u64 addr, void* buffer, u64 size);
+
     virtual bool read_cpureg_dbg(const debugging::cpureg& reg, void* buf,
                                  size_t len) override;
     virtual bool write_cpureg_dbg(const debugging::cpureg& reg, const void*,
                                   size_t len) override;
 
     u64 simulate_cycles(size_t cycles);
+    bool is_irq_pending() const;
+    void skip_idle();
     void processor_thread();
     bool processor_thread_sync();
     bool processor_thread_async();
+    bool processor_thread_parallel();
 
 public:
     property<string> cpuarch;
@@ -76,6 +86,8 @@ public:
 
     property<bool> async;
     property<unsigned int> async_rate;
+    property<bool> parallel;
+    property<bool> idle_skip;
 
     gpio_target_array irq;
 
@@ -92,11 +104,17 @@ public:
     virtual void session_suspend() override;
     virtual void session_resume() override;
 
+    virtual void serialize(checkpoint& cp) override;
+
     virtual u64 cycle_count() const = 0;
 
     double get_run_time() const { return m_run_time; }
     double get_cps() const { return cycle_count() / m_run_time; }
 
+    bool is_idle() const { return m_idle; }
+    u64 get_idle_skips() const { return m_idle_skips; }
+    const sc_time& get_idle_time() const { return m_idle_time; }
+
     virtual void reset() override;
 
     bool get_irq_stats(size_t irq, irq_stats& stats) const;
@@ -120,6 +138,10 @@ protected:
     virtual void interrupt(size_t irq, bool set, gpio_vector vector);
     virtual void interrupt(size_t irq, bool set);
 
+    // called by models to report entering/leaving wait-for-interrupt; calls
+    // from outside the systemc thread take effect on the next update phase
+    void set_idle(bool idle = true);
+
     virtual void simulate(size_t cycles) = 0;
     virtual void update_local_time(sc_time& time, sc_process_b* proc) override;
     virtual void end_of_elaboration() override;
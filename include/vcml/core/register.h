@@ -23,6 +23,18 @@ namespace vcml {
 
 class peripheral;
 
+struct reg_stats {
+    u64 num_reads;
+    u64 num_writes;
+    u64 bytes_read;
+    u64 bytes_written;
+    u64 read_ns;  // host time spent handling reads
+    u64 write_ns; // host time spent handling writes
+
+    u64 num_accesses() const { return num_reads + num_writes; }
+    u64 total_ns() const { return read_ns + write_ns; }
+};
+
 class reg_base : public sc_object
 {
 private:
@@ -37,8 +49,10 @@ private:
     bool m_secure;
     u64 m_privilege;
     peripheral* m_host;
+    reg_stats m_stats;
 
     void do_receive(tlm_generic_payload& tx, const tlm_sbi& info);
+    void do_receive_profiled(tlm_generic_payload& tx, const tlm_sbi& info);
 
 public:
     const address_space as;
@@ -89,6 +103,9 @@ public:
     peripheral* get_host() const { return m_host; }
     int current_cpu() const;
 
+    const reg_stats& get_stats() const { return m_stats; }
+    void reset_stats() { m_stats = reg_stats(); }
+
     reg_base(address_space as, const string& nm, u64 addr, u64 size, u64 n);
     virtual ~reg_base();
 
@@ -100,6 +117,10 @@ public:
 
     virtual void do_read(const range& addr, void* ptr) = 0;
     virtual void do_write(const range& addr, const void* ptr) = 0;
+
+    // accesses from the opposite endian, data in ptr is in host byte order
+    virtual void do_read_swapped(const range& addr, void* ptr);
+    virtual void do_write_swapped(const range& addr, void* ptr);
 };
 
 inline bool reg_base::is_read_only() const {
@@ -110,6 +131,18 @@ inline bool reg_base::is_write_only() const {
     return m_access == VCML_ACCESS_WRITE;
 }
 
+template <typename FN>
+struct reg_callback_traits;
+
+template <typename HOST, typename RET, typename... ARGS>
+struct reg_callback_traits<RET (HOST::*)(ARGS...)> {
+    typedef HOST host;
+    static constexpr size_t nargs = sizeof...(ARGS);
+};
+
+template <auto FN>
+using reg_host_t = typename reg_callback_traits<decltype(FN)>::host;
+
 template <typename DATA, size_t N = 1>
 class reg : public reg_base, public property<DATA, N>
 {
@@ -137,6 +170,12 @@ public:
     template <typename HOST>
     void on_write(void (HOST::*wr)(DATA, size_t), HOST* h = nullptr);
 
+    // binds member functions at compile time, e.g. on_read<&host::fn>()
+    template <auto FN>
+    void on_read(reg_host_t<FN>* host = nullptr);
+    template <auto FN>
+    void on_write(reg_host_t<FN>* host = nullptr);
+
     void on_write_mask(DATA mask);
     void on_write_mask(const array<DATA, N>& mask);
 
@@ -162,10 +201,14 @@ public:
     VCML_KIND(reg);
 
     virtual void reset() override;
+    virtual void serialize(checkpoint& cp) override;
 
     virtual void do_read(const range& addr, void* ptr) override;
     virtual void do_write(const range& addr, const void* ptr) override;
 
+    virtual void do_read_swapped(const range& addr, void* ptr) override;
+    virtual void do_write_swapped(const range& addr, void* ptr) override;
+
     operator DATA() const;
     operator DATA&();
 
@@ -225,26 +268,45 @@ public:
 private:
     bool m_banked;
     DATA m_init[N];
-    std::map<int, DATA*> m_banks;
+    deque<DATA> m_banks; // flat storage of banks 1..n, N values each
 
     readfn m_read;
     writefn m_write;
     readfn_tagged m_read_tagged;
     writefn_tagged m_write_tagged;
 
+    typedef DATA (*read_thunk)(void* host, size_t tag);
+    typedef void (*write_thunk)(void* host, DATA val, size_t tag);
+
+    read_thunk m_read_thunk;
+    write_thunk m_write_thunk;
+    void* m_read_host;
+    void* m_write_host;
+
+    template <auto FN>
+    static DATA read_thunk_fn(void* host, size_t tag);
+    template <auto FN>
+    static void write_thunk_fn(void* host, DATA val, size_t tag);
+
+    bool has_read_callback() const;
+    bool has_write_callback() const;
+
+    template <bool SWAP>
+    void read_cells(const range& addr, void* ptr);
+    template <bool SWAP>
+    void write_cells(const range& addr, const void* ptr);
+
     void init_bank(int bank);
 };
 template <typename DATA, size_t N>
 void reg<DATA, N>::on_read(const readfn& rd) {
-    VCML_ERROR_ON(m_read, "read callback already defined");
-    VCML_ERROR_ON(m_read_tagged, "tagged read callback already defined");
+    VCML_ERROR_ON(has_read_callback(), "read callback already defined");
     m_read = rd;
 }
 
 template <typename DATA, size_t N>
 void reg<DATA, N>::on_read(const readfn_tagged& rd) {
-    VCML_ERROR_ON(m_read, "read callback already defined");
-    VCML_ERROR_ON(m_read_tagged, "tagged read callback already defined");
+    VCML_ERROR_ON(has_read_callback(), "read callback already defined");
     m_read_tagged = rd;
 }
 
@@ -270,15 +332,13 @@ void reg<DATA, N>::on_read(DATA (HOST::*rd)(size_t), HOST* host) {
 
 template <typename DATA, size_t N>
 void reg<DATA, N>::on_write(const writefn& wr) {
-    VCML_ERROR_ON(m_write, "write callback already defined");
-    VCML_ERROR_ON(m_write_tagged, "tagged write callback already defined");
+    VCML_ERROR_ON(has_write_callback(), "write callback already defined");
     m_write = wr;
 }
 
 template <typename DATA, size_t N>
 void reg<DATA, N>::on_write(const writefn_tagged& wr) {
-    VCML_ERROR_ON(m_write, "write callback already defined");
-    VCML_ERROR_ON(m_write_tagged, "tagged write callback already defined");
+    VCML_ERROR_ON(has_write_callback(), "write callback already defined");
     m_write_tagged = wr;
 }
 
@@ -303,6 +363,60 @@ void reg<DATA, N>::on_write(void (HOST::*wr)(DATA, size_t), HOST* host) {
     on_write(fn);
 }
 
+template <typename DATA, size_t N>
+template <auto FN>
+void reg<DATA, N>::on_read(reg_host_t<FN>* host) {
+    if (host == nullptr)
+        host = dynamic_cast<reg_host_t<FN>*>(get_host());
+    VCML_ERROR_ON(!host, "read callback has no host");
+    VCML_ERROR_ON(has_read_callback(), "read callback already defined");
+    m_read_thunk = &read_thunk_fn<FN>;
+    m_read_host = host;
+}
+
+template <typename DATA, size_t N>
+template <auto FN>
+void reg<DATA, N>::on_write(reg_host_t<FN>* host) {
+    if (host == nullptr)
+        host = dynamic_cast<reg_host_t<FN>*>(get_host());
+    VCML_ERROR_ON(!host, "write callback has no host");
+    VCML_ERROR_ON(has_write_callback(), "write callback already defined");
+    m_write_thunk = &write_thunk_fn<FN>;
+    m_write_host = host;
+}
+
+template <typename DATA, size_t N>
+template <auto FN>
+DATA reg<DATA, N>::read_thunk_fn(void* host, size_t tag) {
+    typedef reg_callback_traits<decltype(FN)> traits;
+    auto* obj = static_cast<typename traits::host*>(host);
+    if constexpr (traits::nargs == 0)
+        return (obj->*FN)();
+    else
+        return (obj->*FN)(tag);
+}
+
+template <typename DATA, size_t N>
+template <auto FN>
+void reg<DATA, N>::write_thunk_fn(void* host, DATA val, size_t tag) {
+    typedef reg_callback_traits<decltype(FN)> traits;
+    auto* obj = static_cast<typename traits::host*>(host);
+    if constexpr (traits::nargs == 1)
+        (obj->*FN)(val);
+    else
+        (obj->*FN)(val, tag);
+}
+
+template <typename DATA, size_t N>
+inline bool reg<DATA, N>::has_read_callback() const {
+    return m_read_thunk || m_read || m_read_tagged;
+}
+
+template <typename DATA, size_t N>
+inline bool reg<DATA, N>::has_write_callback() const {
+    return m_write_thunk || m_write || m_write_tagged;
+}
+
 template <typename DATA, size_t N>
 void reg<DATA, N>::on_write_mask(DATA mask) {
     on_write([this, mask](DATA val) -> void {
@@ -332,9 +446,10 @@ const DATA& reg<DATA, N>::bank(int bk, size_t idx) const {
     VCML_ERROR_ON(idx >= N, "index %zu out of bounds", idx);
     if (bk == 0 || !m_banked)
         return property<DATA, N>::get(idx);
-    if (!stl_contains(m_banks, bk))
+    size_t offset = (size_t)(bk - 1) * N + idx;
+    if (bk < 0 || offset >= m_banks.size())
         return property<DATA, N>::get_default();
-    return m_banks.at(bk)[idx];
+    return m_banks[offset];
 }
 
 template <typename DATA, size_t N>
@@ -342,9 +457,10 @@ DATA& reg<DATA, N>::bank(int bk, size_t idx) {
     VCML_ERROR_ON(idx >= N, "index %zu out of bounds", idx);
     if (bk == 0 || !m_banked)
         return property<DATA, N>::get(idx);
-    if (!stl_contains(m_banks, bk))
+    size_t offset = (size_t)(bk - 1) * N + idx;
+    if (bk < 0 || offset >= m_banks.size())
         init_bank(bk);
-    return m_banks[bk][idx];
+    return m_banks[offset];
 }
 
 template <typename DATA, size_t N>
@@ -367,9 +483,14 @@ reg<DATA, N>::reg(const string& nm, u64 addr, DATA def):
     m_read(),
     m_write(),
     m_read_tagged(),
-    m_write_tagged() {
+    m_write_tagged(),
+    m_read_thunk(nullptr),
+    m_write_thunk(nullptr),
+    m_read_host(nullptr),
+    m_write_host(nullptr) {
     for (size_t i = 0; i < N; i++)
         m_init[i] = property<DATA, N>::get(i);
+    property<DATA, N>::set_checkpointed();
 }
 
 template <typename DATA, size_t N>
@@ -382,15 +503,19 @@ reg<DATA, N>::reg(address_space a, const string& nm, u64 addr, DATA d):
     m_read(),
     m_write(),
     m_read_tagged(),
-    m_write_tagged() {
+    m_write_tagged(),
+    m_read_thunk(nullptr),
+    m_write_thunk(nullptr),
+    m_read_host(nullptr),
+    m_write_host(nullptr) {
     for (size_t i = 0; i < N; i++)
         m_init[i] = property<DATA, N>::get(i);
+    property<DATA, N>::set_checkpointed();
 }
 
 template <typename DATA, size_t N>
 reg<DATA, N>::~reg() {
-    for (auto bank : m_banks)
-        delete[] bank.second;
+    // nothing to do
 }
 
 template <typename DATA, size_t N>
@@ -398,14 +523,28 @@ void reg<DATA, N>::reset() {
     for (size_t i = 0; i < N; i++)
         property<DATA, N>::set(m_init[i], i);
 
-    for (auto bank : m_banks) {
-        for (unsigned int i = 0; i < N; i++)
-            m_banks[bank.first][i] = m_init[i];
-    }
+    for (size_t i = 0; i < m_banks.size(); i++)
+        m_banks[i] = m_init[i % N];
 }
 
 template <typename DATA, size_t N>
-void reg<DATA, N>::do_read(const range& txaddr, void* ptr) {
+void reg<DATA, N>::serialize(checkpoint& cp) {
+    for (size_t i = 0; i < N; i++)
+        cp.value(property<DATA, N>::get(i));
+
+    u64 size = m_banks.size();
+    cp.value(size);
+    VCML_ERROR_ON(cp.is_restoring() && size > cp.remaining() / sizeof(DATA),
+                  "checkpoint bank size %llu out of bounds", size);
+    VCML_ERROR_ON(size % N, "checkpoint bank size %llu invalid", size);
+    m_banks.resize(size);
+    for (DATA& val : m_banks)
+        cp.value(val);
+}
+
+template <typename DATA, size_t N>
+template <bool SWAP>
+void reg<DATA, N>::read_cells(const range& txaddr, void* ptr) {
     range addr(txaddr);
     unsigned char* dest = (unsigned char*)ptr;
 
@@ -416,7 +555,9 @@ void reg<DATA, N>::do_read(const range& txaddr, void* ptr) {
 
         DATA val;
 
-        if (m_read_tagged)
+        if (m_read_thunk)
+            val = m_read_thunk(m_read_host, N > 1 ? idx : tag);
+        else if (m_read_tagged)
             val = m_read_tagged(N > 1 ? idx : tag);
         else if (m_read)
             val = m_read();
@@ -426,6 +567,9 @@ void reg<DATA, N>::do_read(const range& txaddr, void* ptr) {
         if (is_writeback())
             current_bank(idx) = val;
 
+        if constexpr (SWAP && sizeof(DATA) > 1)
+            val = bswap(val);
+
         unsigned char* ptr = (unsigned char*)&val + off;
         memcpy(dest, ptr, size);
 
@@ -435,7 +579,8 @@ void reg<DATA, N>::do_read(const range& txaddr, void* ptr) {
 }
 
 template <typename DATA, size_t N>
-void reg<DATA, N>::do_write(const range& txaddr, const void* data) {
+template <bool SWAP>
+void reg<DATA, N>::write_cells(const range& txaddr, const void* data) {
     range addr(txaddr);
     const unsigned char* src = (const unsigned char*)data;
 
@@ -449,7 +594,12 @@ void reg<DATA, N>::do_write(const range& txaddr, const void* data) {
         unsigned char* ptr = (unsigned char*)&val + off;
         memcpy(ptr, src, size);
 
-        if (m_write_tagged)
+        if constexpr (SWAP && sizeof(DATA) > 1)
+            val = bswap(val);
+
+        if (m_write_thunk)
+            m_write_thunk(m_write_host, val, N > 1 ? idx : tag);
+        else if (m_write_tagged)
             m_write_tagged(val, N > 1 ? idx : tag);
         else if (m_write)
             m_write(val);
@@ -461,6 +611,34 @@ void reg<DATA, N>::do_write(const range& txaddr, const void* data) {
     }
 }
 
+template <typename DATA, size_t N>
+void reg<DATA, N>::do_read(const range& addr, void* ptr) {
+    read_cells<false>(addr, ptr);
+}
+
+template <typename DATA, size_t N>
+void reg<DATA, N>::do_write(const range& addr, const void* ptr) {
+    write_cells<false>(addr, ptr);
+}
+
+template <typename DATA, size_t N>
+void reg<DATA, N>::do_read_swapped(const range& addr, void* ptr) {
+    // whole cells can be swapped in place, everything else is handled by
+    // swapping the entire transaction buffer
+    if (addr.start % sizeof(DATA) || addr.length() != sizeof(DATA))
+        reg_base::do_read_swapped(addr, ptr);
+    else
+        read_cells<true>(addr, ptr);
+}
+
+template <typename DATA, size_t N>
+void reg<DATA, N>::do_write_swapped(const range& addr, void* ptr) {
+    if (addr.start % sizeof(DATA) || addr.length() != sizeof(DATA))
+        reg_base::do_write_swapped(addr, ptr);
+    else
+        write_cells<true>(addr, ptr);
+}
+
 template <typename DATA, size_t N>
 reg<DATA, N>::operator DATA() const {
     return current_bank();
@@ -671,13 +849,13 @@ inline void reg<DATA, N>::set_bit(bool set) {
 template <typename DATA, size_t N>
 void reg<DATA, N>::init_bank(int bank) {
     VCML_ERROR_ON(!m_banked, "cannot create banks in register %s", name());
+    VCML_ERROR_ON(bank < 0, "invalid bank %d in register %s", bank, name());
 
-    if (bank == 0 || stl_contains(m_banks, bank))
-        return;
-
-    m_banks[bank] = new DATA[N];
-    for (size_t i = 0; i < N; i++)
-        m_banks[bank][i] = m_init[i];
+    // growing at the end keeps references to existing banks valid
+    while (m_banks.size() < (size_t)bank * N) {
+        for (size_t i = 0; i < N; i++)
+            m_banks.push_back(m_init[i]);
+    }
 }
 
 } // namespace vcml
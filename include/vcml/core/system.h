@@ -14,6 +14,7 @@
 #include "vcml/core/types.h"
 #include "vcml/core/module.h"
 #include "vcml/core/register.h"
+#include "vcml/core/peripheral.h"
 
 #include "vcml/debugging/vspserver.h"
 
@@ -23,6 +24,10 @@ class system : public module
 {
 private:
     void timeout();
+    void write_regstats();
+
+    bool cmd_checkpoint(const vector<string>& args, ostream& os);
+    bool cmd_restore(const vector<string>& args, ostream& os);
 
 public:
     property<string> name;
@@ -37,6 +42,11 @@ public:
     property<sc_time> quantum;
     property<sc_time> duration;
 
+    property<bool> profile_registers;
+    property<string> regstats;
+
+    property<string> restore;
+
     system() = delete;
     system(const system&) = delete;
     explicit system(const sc_module_name& name);
@@ -44,6 +54,12 @@ public:
     VCML_KIND(system);
 
     virtual int run();
+
+    static void save_checkpoint(const string& filename);
+    static void load_checkpoint(const string& filename);
+
+protected:
+    virtual void start_of_simulation() override;
 };
 
 } // namespace vcml
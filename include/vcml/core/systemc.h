@@ -319,8 +319,14 @@ class async_timer
 {
 public:
     struct event {
-        async_timer* owner;
+        atomic<async_timer*> owner;
         sc_time timeout;
+        event* prev;
+        event* next;
+        size_t slot;
+
+        event(async_timer* t, const sc_time& to):
+            owner(t), timeout(to), prev(), next(), slot(~(size_t)0) {}
     };
 
     size_t count() const { return m_triggers; }
@@ -356,11 +362,38 @@ void sc_async(function<void(void)> job);
 void sc_progress(const sc_time& delta);
 void sc_sync(function<void(void)> job);
 
+// blocks the calling async thread until cond holds or simulation ends; cond
+// may only depend on state the SystemC thread publishes before waking async
+// threads, i.e. time progress, completed sc_sync requests or simulation end
+void sc_async_wait(const function<bool(void)>& cond);
+
+// number of polls before a waiting async thread goes to sleep
+void set_async_spin_limit(size_t iterations);
+size_t async_spin_limit();
+
 bool sc_is_async();
 
+// keeps the kernel waiting for async events instead of starving while
+// all processes are blocked; calls must be balanced
+void kernel_keep_alive(bool keep);
+
+enum quantum_activity {
+    QUANTUM_ACTIVITY_IRQ = 0,   // interrupt line asserted at a processor
+    QUANTUM_ACTIVITY_SYNC = 1,  // access to a sync_on_read/write register
+    QUANTUM_ACTIVITY_ASYNC = 2, // request injected from a foreign thread
+    NUM_QUANTUM_ACTIVITIES
+};
+
+// event counters that let quantum controllers spot timing-sensitive phases
+void report_quantum_activity(quantum_activity kind);
+u64 quantum_activity_count(quantum_activity kind);
+
 sc_time async_time_stamp();
 sc_time async_time_offset();
 
+// global quantum snapshot that is safe to read from async threads
+sc_time async_quantum();
+
 bool is_thread(sc_process_b* proc = nullptr);
 bool is_method(sc_process_b* proc = nullptr);
 
@@ -368,6 +401,12 @@ sc_process_b* current_process();
 sc_process_b* current_thread();
 sc_process_b* current_method();
 
+// returns a small dense index for the given process, index 0 is reserved
+// for code running outside of any process; indices of terminated dynamic
+// processes are reused, serial changes whenever an index is handed out
+size_t process_index(sc_process_b* proc);
+size_t process_index(sc_process_b* proc, u64& serial);
+
 bool is_stop_requested();
 void request_stop();
 
@@ -25,6 +25,9 @@ class disk : public module
 {
 private:
     backend* m_backend;
+    std::set<size_t> m_dirty;
+
+    void mark_dirty(size_t pos, size_t size);
 
     bool cmd_show_stats(const vector<string>& args, ostream& os);
     bool cmd_save_image(const vector<string>& args, ostream& os);
@@ -58,6 +61,11 @@ public:
     virtual ~disk();
     VCML_KIND(block::drive);
 
+    static constexpr size_t DIRTY_BLOCK_SIZE = 4 * KiB;
+    size_t num_dirty_blocks() const { return m_dirty.size(); }
+
+    virtual void serialize(checkpoint& cp) override;
+
     size_t capacity();
     size_t pos();
     size_t remaining();
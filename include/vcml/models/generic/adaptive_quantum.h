@@ -0,0 +1,74 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef VCML_GENERIC_ADAPTIVE_QUANTUM_H
+#define VCML_GENERIC_ADAPTIVE_QUANTUM_H
+
+#include "vcml/core/types.h"
+#include "vcml/core/systemc.h"
+#include "vcml/core/module.h"
+#include "vcml/core/model.h"
+
+namespace vcml {
+namespace generic {
+
+// grows the global quantum while the system is quiet and shrinks it as soon
+// as interrupts, synchronizing register accesses or async requests show up
+class adaptive_quantum : public module
+{
+private:
+    u64 m_last[NUM_QUANTUM_ACTIVITIES];
+    u64 m_delta[NUM_QUANTUM_ACTIVITIES];
+    size_t m_adjustments;
+    bool m_disabled;
+    std::ofstream m_log;
+
+    bool has_parallel_processors(sc_object* obj) const;
+    bool is_tracked(quantum_activity kind) const;
+    u64 collect_activity();
+    sc_time next_quantum(const sc_time& curr, u64 activity) const;
+
+    void log_sample(const sc_time& next);
+    void control();
+
+public:
+    property<sc_time> min_quantum;
+    property<sc_time> max_quantum;
+
+    property<string> policy;
+    property<double> grow;
+    property<double> shrink;
+
+    property<unsigned int> interval;
+    property<unsigned int> threshold;
+
+    property<bool> track_irq;
+    property<bool> track_sync;
+    property<bool> track_async;
+
+    property<string> logfile;
+
+    size_t adjustments() const { return m_adjustments; }
+    bool is_disabled() const { return m_disabled; }
+    sc_time current() const { return tlm_global_quantum::instance().get(); }
+
+    adaptive_quantum() = delete;
+    adaptive_quantum(const sc_module_name& nm);
+    virtual ~adaptive_quantum();
+    VCML_KIND(adaptive_quantum);
+
+protected:
+    void end_of_elaboration() override;
+};
+
+} // namespace generic
+} // namespace vcml
+
+#endif
@@ -30,6 +30,11 @@ private:
         SOURCE_ANY = SIZE_MAX,
     };
 
+    enum : u64 {
+        ROUTE_PAGE_BITS = 12,
+        ROUTE_CACHE_SIZE = 16,
+    };
+
     struct mapping {
         size_t target;
         size_t source;
@@ -39,6 +44,25 @@ private:
         bool operator<(const mapping& m) const;
     };
 
+    struct decoder {
+        vector<const mapping*> entries;
+
+        size_t depth() const;
+        bool overlaps(const range& addr) const;
+        const mapping* find(const range& addr) const;
+    };
+
+    struct route {
+        u64 page = 0;
+        const mapping* target = nullptr;
+    };
+
+    struct route_cache {
+        route routes[ROUTE_CACHE_SIZE];
+        u64 hits = 0;
+        u64 misses = 0;
+    };
+
     std::map<size_t, sc_object*> m_target_peers;
     std::map<size_t, sc_object*> m_source_peers;
 
@@ -51,12 +75,31 @@ private:
     set<mapping> m_mappings;
     mapping m_default;
 
-    const mapping& lookup(tlm_target_socket& src, const range& addr) const;
+    decoder m_decoder;
+    vector<decoder> m_source_decoders;
+    bool m_elaborated;
+    bool m_stale;
+
+    // only used from b_transport, which always runs on the systemc thread
+    vector<route_cache> m_route_caches;
+
+    void build_decoders();
+    void update_decoders();
+    void flush_routes();
+    void invalidate_mapping(const mapping& m);
+
+    bool is_uniform(size_t port, const mapping& m, const range& page) const;
+
+    const mapping& decode(size_t port, const range& addr);
+    const mapping& lookup(tlm_target_socket& src, const range& addr);
     void handle_bus_error(tlm_generic_payload& tx) const;
 
     bool cmd_mmap(const vector<string>& args, ostream& os);
+    bool cmd_routes(const vector<string>& args, ostream& os);
 
 protected:
+    virtual void end_of_elaboration() override;
+
     virtual void b_transport(tlm_target_socket& origin,
                              tlm_generic_payload& tx, sc_time& dt) override;
 
@@ -89,9 +132,16 @@ public:
 
     void map_default(size_t target, u64 offset = 0);
 
+    void unmap(size_t target);
+    void unmap(size_t target, const range& addr);
+    void unmap(size_t target, u64 lo, u64 hi);
+
     void stub(const range& addr, tlm_response_status rs = TLM_OK_RESPONSE);
     void stub(u64 lo, u64 hi, tlm_response_status rs = TLM_OK_RESPONSE);
 
+    u64 route_hits(size_t port) const;
+    u64 route_misses(size_t port) const;
+
     template <typename SOURCE>
     void stub(SOURCE& s, const range& addr,
               tlm_response_status rs = TLM_OK_RESPONSE);
@@ -140,6 +190,10 @@ inline void bus::map(size_t target, u64 lo, u64 hi, u64 offset, size_t src) {
     map(target, range(lo, hi), offset, src);
 }
 
+inline void bus::unmap(size_t target, u64 lo, u64 hi) {
+    unmap(target, range(lo, hi));
+}
+
 inline void bus::stub(const range& addr, tlm_response_status rs) {
     size_t target_port = out.next_index();
     out[target_port].stub(rs);
@@ -27,16 +27,32 @@ class memory : public peripheral, public debugging::loader
 {
 private:
     tlm_memory m_memory;
+    tlm_sparse_memory* m_sparse;
+
+    void show_placement(ostream& os);
+    void update_dmi();
+    void serialize_sparse(checkpoint& cp);
 
     bool cmd_show(const vector<string>& args, ostream& os);
+    bool cmd_snapshot(const vector<string>& args, ostream& os);
+    bool cmd_restore(const vector<string>& args, ostream& os);
 
     memory();
     memory(const memory&);
 
 protected:
+    virtual void load_bin(const string& filename, u64 offset) override;
+
     virtual u8* allocate_image(u64 size, u64 offset) override;
     virtual void copy_image(const u8* img, u64 size, u64 offset) override;
 
+    virtual bool is_memory_like(const range& addr,
+                                address_space as) const override;
+
+    virtual bool get_direct_mem_ptr(tlm_target_socket& origin,
+                                    tlm_generic_payload& tx,
+                                    tlm_dmi& dmi) override;
+
 public:
     property<u64> size;
     property<alignment> align;
@@ -44,12 +60,24 @@ public:
     property<bool> readonly;
     property<string> shared;
     property<vector<string>> images;
+    property<bool> map_images;
     property<u8> poison;
+    property<bool> hugetlb;
+    property<bool> hugepages;
+    property<bool> prefault;
+    property<int> numa_node;
+    property<bool> sparse;
 
     tlm_target_socket in;
 
     u8* data() const { return m_memory.data(); }
 
+    bool is_sparse() const { return m_sparse != nullptr; }
+    const tlm_sparse_memory* sparse_memory() const { return m_sparse; }
+
+    void track_dirty(bool enable = true);
+    vector<range> fetch_dirty(bool clear = true);
+
     u8& operator[](size_t idx) { return m_memory[idx]; }
     u8 operator[](size_t idx) const { return m_memory[idx]; }
 
@@ -59,6 +87,11 @@ public:
     virtual ~memory();
     VCML_KIND(memory);
     virtual void reset() override;
+    virtual void serialize(checkpoint& cp) override;
+
+    virtual unsigned int transport(tlm_generic_payload& tx,
+                                   const tlm_sbi& info,
+                                   address_space as) override;
 
     virtual tlm_response_status read(const range& addr, void* data,
                                      const tlm_sbi& info) override;
@@ -27,6 +27,7 @@ class aclint : public peripheral
 {
 private:
     sc_time m_time_reset;
+    u64 m_cycles_reset;
     sc_event m_trigger;
 
     u64 get_cycles() const;
@@ -77,6 +78,7 @@ public:
     VCML_KIND(riscv::aclint);
 
     virtual void reset() override;
+    virtual void serialize(checkpoint& cp) override;
 };
 
 } // namespace riscv
@@ -42,7 +42,7 @@ public:
     {
     private:
         sc_event m_ev;
-        sc_time m_prev;
+        sc_time m_period;
         sc_time m_next;
         sp804* m_timer;
 
@@ -97,6 +97,7 @@ public:
         VCML_KIND(arm::sp804::timer);
 
         virtual void reset() override;
+        virtual void serialize(checkpoint& cp) override;
     };
 
     enum timer_address : u64 {
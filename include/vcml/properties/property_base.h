@@ -13,6 +13,7 @@
 
 #include "vcml/core/types.h"
 #include "vcml/core/systemc.h"
+#include "vcml/core/checkpoint.h"
 
 namespace vcml {
 
@@ -21,6 +22,7 @@ class property_base : public sc_attr_base
 private:
     sc_object* m_parent;
     string m_fullname;
+    bool m_checkpointed;
 
 public:
     property_base(const char* name);
@@ -36,11 +38,18 @@ public:
     const char* basename() const { return name().c_str(); }
     const char* fullname() const { return m_fullname.c_str(); }
 
+    // properties hold configuration of the current run by default and are
+    // only stored in checkpoints if they are marked as simulation state
+    bool is_checkpointed() const { return m_checkpointed; }
+    void set_checkpointed(bool set = true) { m_checkpointed = set; }
+
     virtual void reset() = 0;
 
     virtual const char* str() const = 0;
     virtual void str(const string& s) = 0;
 
+    virtual void serialize(checkpoint& cp);
+
     virtual size_t size() const = 0;
     virtual size_t count() const = 0;
     virtual const char* type() const = 0;
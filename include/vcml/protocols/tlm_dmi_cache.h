@@ -20,19 +20,42 @@ namespace vcml {
 class tlm_dmi_cache
 {
 private:
+    struct table {
+        vector<tlm_dmi> entries; // sorted by start address
+        vector<u64> limits;      // highest end address up to entry i
+        vector<u64> stamps;      // insertion order, used for eviction
+
+        void insert(const tlm_dmi& dmi, u64 stamp);
+        void remove(size_t idx);
+        void update();
+
+        const tlm_dmi* find(const range& r, vcml_access rwx) const;
+    };
+
     mutable mutex m_mtx;
 
     size_t m_limit;
-    vector<tlm_dmi> m_entries;
+    u64 m_stamp;
+
+    atomic<table*> m_table;
+    atomic<u64> m_generation;
+
+    mutable atomic<size_t> m_epoch;
+    mutable atomic<size_t> m_readers[2];
+
+    size_t read_lock() const;
+    void read_unlock(size_t epoch) const;
 
-    void insert_locked(const tlm_dmi& dmi);
+    // writers copy the table, so inserts cost O(limit) and only happen when
+    // a new region is granted; lookups never wait for writers
+    void publish(table* next);
+    void insert_locked(table& t, const tlm_dmi& dmi);
 
 public:
     size_t get_entry_limit() const { return m_limit; }
     void set_entry_limit(size_t lim) { m_limit = lim; }
 
-    vector<tlm_dmi> get_entries() { return m_entries; }
-    const vector<tlm_dmi>& get_entries() const { return m_entries; }
+    vector<tlm_dmi> get_entries() const;
 
     tlm_dmi_cache();
     virtual ~tlm_dmi_cache();
@@ -48,6 +71,20 @@ public:
     bool lookup(const tlm_generic_payload& tx, tlm_dmi& dmi);
 };
 
+inline size_t tlm_dmi_cache::read_lock() const {
+    while (true) {
+        size_t epoch = m_epoch.load(std::memory_order_acquire);
+        m_readers[epoch & 1]++;
+        if (m_epoch.load() == epoch)
+            return epoch;
+        m_readers[epoch & 1]--;
+    }
+}
+
+inline void tlm_dmi_cache::read_unlock(size_t epoch) const {
+    m_readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+}
+
 inline bool tlm_dmi_cache::lookup(const range& addr, tlm_command command,
                                   tlm_dmi& dmi) {
     return lookup(addr, tlm_command_to_access(command), dmi);
@@ -28,12 +28,30 @@ struct exlock {
 class tlm_exmon
 {
 private:
+    // locks are indexed by the cache line granules they cover, locks that
+    // span too many granules are kept separately and checked individually
+    static constexpr u64 GRANULE_BITS = 6;
+    static constexpr u64 MAX_GRANULES = 4;
+
     vector<exlock> m_locks;
+    vector<size_t> m_slots; // cpu -> index into m_locks + 1, zero if unused
+    unordered_map<u64, vector<int>> m_granules;
+    vector<int> m_wide;
+
+    mutable vector<int> m_found;
+
+    static u64 num_granules(const range& r);
+
+    void insert_lock(int cpu, const range& r);
+    void remove_lock(int cpu);
+
+    const vector<int>& find_locks(const range& r) const;
 
 public:
     const vector<exlock> get_locks() const { return m_locks; }
+    bool has_locks() const { return !m_locks.empty(); }
 
-    tlm_exmon() = default;
+    tlm_exmon();
     virtual ~tlm_exmon() = default;
 
     bool has_lock(int cpu, const range& r) const;
@@ -47,6 +65,10 @@ public:
     bool override_dmi(const tlm_generic_payload& tx, tlm_dmi& dmi);
 };
 
+inline u64 tlm_exmon::num_granules(const range& r) {
+    return (r.end >> GRANULE_BITS) - (r.start >> GRANULE_BITS) + 1;
+}
+
 } // namespace vcml
 
 #endif
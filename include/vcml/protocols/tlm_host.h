@@ -30,13 +30,19 @@ private:
         sc_time time;
         tlm_generic_payload* tx;
         const tlm_sbi* sbi;
-        proc_data(): time(SC_ZERO_TIME), tx(nullptr), sbi(nullptr) {}
+        u64 serial;
+        proc_data():
+            time(SC_ZERO_TIME), tx(nullptr), sbi(nullptr), serial(0) {}
     };
 
-    mutable std::unordered_map<sc_process_b*, proc_data> m_processes;
+    // indexed by process_index, deque keeps references to local time stable;
+    // slots of reused indices are reset when the serial no longer matches
+    mutable deque<proc_data> m_processes;
     vector<tlm_initiator_socket*> m_initiator_sockets;
     vector<tlm_target_socket*> m_target_sockets;
 
+    proc_data& process_data(sc_process_b* proc) const;
+
     unsigned int do_transport(tlm_target_socket& socket,
                               tlm_generic_payload& tx, const tlm_sbi& info);
 
@@ -111,43 +117,66 @@ public:
     property<bool> allow_dmi;
 };
 
+inline tlm_host::proc_data& tlm_host::process_data(sc_process_b* proc) const {
+    u64 serial;
+    size_t idx = process_index(proc, serial);
+    if (idx >= m_processes.size())
+        m_processes.resize(idx + 1);
+
+    proc_data& data = m_processes[idx];
+    if (data.serial != serial) {
+        data = proc_data();
+        data.serial = serial;
+    }
+
+    return data;
+}
+
 inline bool tlm_host::in_transaction(sc_process_b* proc) const {
-    return m_processes[proc].tx != nullptr;
+    return process_data(proc).tx != nullptr;
 }
 
 inline bool tlm_host::in_debug_transaction(sc_process_b* proc) const {
-    return m_processes[proc].sbi && m_processes[proc].sbi->is_debug;
+    const tlm_sbi* sbi = process_data(proc).sbi;
+    return sbi && sbi->is_debug;
 }
 
 inline bool tlm_host::in_secure_transaction(sc_process_b* proc) const {
-    return m_processes[proc].sbi && m_processes[proc].sbi->is_secure;
+    const tlm_sbi* sbi = process_data(proc).sbi;
+    return sbi && sbi->is_secure;
 }
 
 inline int tlm_host::current_cpu(sc_process_b* proc) const {
-    return m_processes[proc].sbi ? m_processes[proc].sbi->cpuid : -1;
+    const tlm_sbi* sbi = process_data(proc).sbi;
+    return sbi ? sbi->cpuid : -1;
 }
 
 inline int tlm_host::current_privilege(sc_process_b* proc) const {
-    return m_processes[proc].sbi ? m_processes[proc].sbi->privilege : 0;
+    const tlm_sbi* sbi = process_data(proc).sbi;
+    return sbi ? sbi->privilege : 0;
 }
 
 inline const tlm_generic_payload& tlm_host::current_transaction(
     sc_process_b* proc) const {
-    VCML_ERROR_ON(!m_processes[proc].tx, "no current transaction");
-    return *m_processes[proc].tx;
+    const tlm_generic_payload* tx = process_data(proc).tx;
+    VCML_ERROR_ON(!tx, "no current transaction");
+    return *tx;
 }
 
 inline const tlm_sbi& tlm_host::current_sideband(sc_process_b* proc) const {
-    VCML_ERROR_ON(!m_processes[proc].sbi, "no current transaction");
-    return *m_processes[proc].sbi;
+    const tlm_sbi* sbi = process_data(proc).sbi;
+    VCML_ERROR_ON(!sbi, "no current transaction");
+    return *sbi;
 }
 
 inline size_t tlm_host::current_transaction_size(sc_process_b* proc) const {
-    return m_processes[proc].tx ? m_processes[proc].tx->get_data_length() : 0;
+    const tlm_generic_payload* tx = process_data(proc).tx;
+    return tx ? tx->get_data_length() : 0;
 }
 
 inline range tlm_host::current_transaction_address(sc_process_b* proc) const {
-    return m_processes[proc].tx ? range(*m_processes[proc].tx) : range();
+    const tlm_generic_payload* tx = process_data(proc).tx;
+    return tx ? range(*tx) : range();
 }
 
 inline const vector<tlm_initiator_socket*>&
@@ -23,13 +23,23 @@ namespace vcml {
 class tlm_memory : public tlm_dmi
 {
 private:
+    struct snapshot_image;
+
     void* m_handle;
     void* m_base;
     size_t m_size;
     bool m_discard;
+    bool m_hugetlb;
+    bool m_hugepages;
+    bool m_prefaulted;
+    int m_numa_node;
     string m_shared;
+    unordered_map<string, snapshot_image*> m_snapshots;
+    bool m_tracking;
+    vector<u64> m_dirty;
 
     int init_shared(const string& shared, size_t size);
+    void map_snapshot(const snapshot_image& image);
 
 public:
     u8* data() const { return get_dmi_ptr(); }
@@ -43,6 +53,31 @@ public:
 
     void discard_writes(bool discard = true) { m_discard = discard; }
 
+    bool has_hugetlb() const { return m_hugetlb; }
+    bool has_hugepages() const { return m_hugepages; }
+    bool is_prefaulted() const { return m_prefaulted; }
+    int numa_node() const { return m_numa_node; }
+
+    // placement hints, these return false if the host refuses them
+    bool use_hugepages();
+    bool bind_numa(unsigned int node);
+    bool prefault();
+
+    // maps a file copy-on-write at the given offset instead of copying it,
+    // identical files share their pages across all memories in the process
+    bool map_file(const string& filename, u64 offset);
+    static size_t cached_images();
+
+    enum : u64 { DIRTY_PAGE_BITS = 12 };
+
+    // dirty tracking only sees writes made via this class, callers must
+    // revoke write DMI pointers or call mark_dirty themselves
+    bool is_tracking_dirty() const { return m_tracking; }
+    void track_dirty(bool enable = true);
+    void mark_dirty(const range& addr);
+    bool is_dirty(const range& addr) const;
+    vector<range> fetch_dirty(bool clear = true);
+
     tlm_memory();
     tlm_memory(size_t size);
     tlm_memory(size_t size, alignment al);
@@ -53,10 +88,18 @@ public:
     virtual ~tlm_memory();
 
     void init(size_t size, alignment al);
-    void init(const string& shared, size_t size, alignment al);
+    void init(const string& shared, size_t size, alignment al,
+              bool hugetlb = false);
     void free();
     void fill(u8 data);
 
+    // snapshots are copy-on-write, restoring only drops modified pages
+    bool has_snapshot(const string& name) const;
+    vector<string> snapshots() const;
+    bool snapshot(const string& name);
+    bool restore(const string& name);
+    void drop_snapshot(const string& name);
+
     tlm_response_status fill(u8 data, bool debug);
 
     tlm_response_status read(const range& addr, void* dest,
@@ -83,6 +126,21 @@ inline void tlm_memory::init(size_t size, alignment al) {
 
 inline void tlm_memory::fill(u8 val) {
     memset(data(), val, size());
+    mark_dirty({ 0, size() - 1 });
+}
+
+inline void tlm_memory::mark_dirty(const range& addr) {
+    if (!m_tracking)
+        return;
+
+    u64 first = addr.start >> DIRTY_PAGE_BITS;
+    u64 last = min<u64>(addr.end >> DIRTY_PAGE_BITS, m_dirty.size() * 64 - 1);
+    for (u64 page = first; page <= last; page++)
+        m_dirty[page / 64] |= 1ull << (page % 64);
+}
+
+inline bool tlm_memory::has_snapshot(const string& name) const {
+    return stl_contains(m_snapshots, name);
 }
 
 template <typename T>
@@ -0,0 +1,77 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef VCML_PROTOCOLS_TLM_MM_H
+#define VCML_PROTOCOLS_TLM_MM_H
+
+#include "vcml/core/types.h"
+#include "vcml/core/systemc.h"
+
+#include "vcml/protocols/tlm_sbi.h"
+
+namespace vcml {
+
+// hands out payloads that already carry an sbiext; released payloads are
+// scrubbed and kept for reuse instead of being returned to the heap
+class tlm_mm : public tlm::tlm_mm_interface
+{
+private:
+    mutable mutex m_mtx;
+    vector<tlm_generic_payload*> m_pool;
+
+    size_t m_allocations;
+    size_t m_reuses;
+    size_t m_in_use;
+
+public:
+    size_t allocations() const { return m_allocations; }
+    size_t reuses() const { return m_reuses; }
+    size_t in_use() const { return m_in_use; }
+    size_t pooled() const;
+
+    tlm_mm();
+    virtual ~tlm_mm();
+
+    tlm_mm(const tlm_mm&) = delete;
+    tlm_mm& operator=(const tlm_mm&) = delete;
+
+    tlm_generic_payload* allocate();
+    virtual void free(tlm_generic_payload* tx) override;
+
+    static tlm_mm& instance();
+};
+
+inline size_t tlm_mm::pooled() const {
+    lock_guard<mutex> guard(m_mtx);
+    return m_pool.size();
+}
+
+// scoped reference to a pooled payload, released when going out of scope
+class tlm_pooled_payload
+{
+private:
+    tlm_generic_payload* m_tx;
+
+public:
+    tlm_pooled_payload(tlm_mm& mm = tlm_mm::instance()):
+        m_tx(mm.allocate()) {}
+    ~tlm_pooled_payload() { m_tx->release(); }
+
+    tlm_pooled_payload(const tlm_pooled_payload&) = delete;
+    tlm_pooled_payload& operator=(const tlm_pooled_payload&) = delete;
+
+    tlm_generic_payload& operator*() const { return *m_tx; }
+    tlm_generic_payload* operator->() const { return m_tx; }
+    operator tlm_generic_payload&() const { return *m_tx; }
+};
+
+} // namespace vcml
+
+#endif
@@ -18,6 +18,7 @@
 #include "vcml/core/module.h"
 
 #include "vcml/protocols/tlm_sbi.h"
+#include "vcml/protocols/tlm_mm.h"
 #include "vcml/protocols/tlm_exmon.h"
 #include "vcml/protocols/tlm_stubs.h"
 #include "vcml/protocols/tlm_adapters.h"
@@ -29,14 +30,21 @@
 
 namespace vcml {
 
+struct tlm_iovec {
+    u64 addr;
+    void* data;
+    unsigned int size;
+};
+
 class tlm_initiator_socket
     : public simple_initiator_socket<tlm_initiator_socket>
 {
 private:
-    tlm_generic_payload m_tx;
-    tlm_generic_payload m_txd;
+    tlm_generic_payload& m_tx;
+    tlm_generic_payload& m_txd;
     tlm_sbi m_sbi;
     tlm_dmi_cache* m_dmi_cache;
+    vector<u8> m_bounce;
     tlm_target_stub* m_stub;
     tlm_host* m_host;
     module* m_parent;
@@ -97,6 +105,20 @@ public:
                               const tlm_sbi& info = SBI_NONE,
                               unsigned int* nbytes = nullptr);
 
+    // vectored accesses merge entries that are contiguous in guest memory
+    // into a single DMI copy or a single burst transaction
+    tlm_response_status accessv(tlm_command cmd, const vector<tlm_iovec>& iov,
+                                const tlm_sbi& info = SBI_NONE,
+                                unsigned int* nbytes = nullptr);
+
+    tlm_response_status readv(const vector<tlm_iovec>& iov,
+                              const tlm_sbi& info = SBI_NONE,
+                              unsigned int* nbytes = nullptr);
+
+    tlm_response_status writev(const vector<tlm_iovec>& iov,
+                               const tlm_sbi& info = SBI_NONE,
+                               unsigned int* nbytes = nullptr);
+
     template <typename T>
     tlm_response_status readw(u64 addr, T& data,
                               const tlm_sbi& info = SBI_NONE,
@@ -174,6 +196,16 @@ inline tlm_response_status tlm_initiator_socket::write(u64 addr,
     return access(TLM_WRITE_COMMAND, addr, ptr, size, info, bytes);
 }
 
+inline tlm_response_status tlm_initiator_socket::readv(
+    const vector<tlm_iovec>& iov, const tlm_sbi& info, unsigned int* nbytes) {
+    return accessv(TLM_READ_COMMAND, iov, info, nbytes);
+}
+
+inline tlm_response_status tlm_initiator_socket::writev(
+    const vector<tlm_iovec>& iov, const tlm_sbi& info, unsigned int* nbytes) {
+    return accessv(TLM_WRITE_COMMAND, iov, info, nbytes);
+}
+
 template <typename T>
 inline tlm_response_status tlm_initiator_socket::readw(u64 addr, T& data,
                                                        const tlm_sbi& info,
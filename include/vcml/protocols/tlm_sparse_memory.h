@@ -0,0 +1,99 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef VCML_PROTOCOLS_TLM_SPARSE_MEMORY_H
+#define VCML_PROTOCOLS_TLM_SPARSE_MEMORY_H
+
+#include "vcml/core/types.h"
+#include "vcml/core/range.h"
+#include "vcml/core/systemc.h"
+
+#include "vcml/protocols/tlm_sbi.h"
+
+namespace vcml {
+
+// guest memory that only allocates host pages once they are written to,
+// untouched pages read as zero and do not consume any host memory
+class tlm_sparse_memory
+{
+public:
+    enum : u64 {
+        PAGE_BITS = 21,
+        PAGE_SIZE = 1ull << PAGE_BITS,
+        TABLE_BITS = 9,
+        TABLE_SIZE = 1ull << TABLE_BITS,
+    };
+
+private:
+    struct table {
+        void* entries[TABLE_SIZE];
+    };
+
+    u64 m_size;
+    unsigned int m_levels;
+    table* m_root;
+    bool m_readonly;
+    bool m_discard;
+
+    size_t m_pages;
+    size_t m_tables;
+
+    void free_table(table* tab, unsigned int level);
+    void collect(const table* tab, unsigned int level, u64 page,
+                 vector<u64>& pages) const;
+    size_t table_index(u64 page, unsigned int level) const;
+
+public:
+    u64 size() const { return m_size; }
+    unsigned int levels() const { return m_levels; }
+
+    size_t resident_pages() const { return m_pages; }
+    size_t resident_tables() const { return m_tables; }
+    u64 resident_bytes() const { return m_pages * PAGE_SIZE; }
+
+    void allow_read_only(bool ro = true) { m_readonly = ro; }
+    void discard_writes(bool discard = true) { m_discard = discard; }
+
+    tlm_sparse_memory(u64 size);
+    tlm_sparse_memory(const tlm_sparse_memory&) = delete;
+    ~tlm_sparse_memory();
+
+    u8* lookup(u64 addr) const;
+    u8* populate(u64 addr);
+    void clear();
+
+    // start addresses of all resident pages in ascending order
+    vector<u64> resident() const;
+
+    bool get_dmi(u64 addr, tlm_dmi& dmi) const;
+
+    tlm_response_status read(const range& addr, void* dest,
+                             bool debug = false) const;
+    tlm_response_status write(const range& addr, const void* src,
+                              bool debug = false);
+
+    void transport(tlm_generic_payload& tx, const tlm_sbi& sbi);
+};
+
+inline size_t tlm_sparse_memory::table_index(u64 page, unsigned int lvl) const {
+    return (page >> (TABLE_BITS * (m_levels - lvl - 1))) & (TABLE_SIZE - 1);
+}
+
+inline u8* tlm_sparse_memory::lookup(u64 addr) const {
+    const u64 page = addr >> PAGE_BITS;
+    void* node = m_root;
+    for (unsigned int lvl = 0; node && lvl < m_levels; lvl++)
+        node = ((table*)node)->entries[table_index(page, lvl)];
+    return node ? (u8*)node + (addr & (PAGE_SIZE - 1)) : nullptr;
+}
+
+} // namespace vcml
+
+#endif
@@ -0,0 +1,243 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/core/checkpoint.h"
+#include "vcml/core/module.h"
+
+namespace vcml {
+
+template <typename T>
+static void write_raw(ostream& os, const T& val) {
+    os.write((const char*)&val, sizeof(val));
+}
+
+template <typename T>
+static void read_raw(istream& is, T& val) {
+    is.read((char*)&val, sizeof(val));
+}
+
+static u64 bytes_left(istream& is, u64 total) {
+    if (!is.good())
+        return 0;
+    u64 pos = is.tellg();
+    return pos < total ? total - pos : 0;
+}
+
+void checkpoint::finish_section() {
+    if (m_section == nullptr || is_restoring())
+        return;
+
+    // patch the size of the section now that all its data is written
+    m_section->size = m_pos;
+    std::streampos end = m_file.tellp();
+    m_file.seekp(m_section->offset - sizeof(u64));
+    write_raw<u64>(m_file, m_section->size);
+    m_file.seekp(end);
+    m_section = nullptr;
+}
+
+void checkpoint::capture(sc_object* obj) {
+    module* mod = dynamic_cast<module*>(obj);
+    if (mod != nullptr) {
+        enter(mod->name());
+        mod->serialize(*this);
+    }
+
+    for (sc_object* child : obj->get_child_objects())
+        capture(child);
+}
+
+void checkpoint::apply(sc_object* obj) {
+    module* mod = dynamic_cast<module*>(obj);
+    if (mod != nullptr) {
+        if (enter(mod->name())) {
+            mod->serialize(*this);
+            if (remaining() > 0)
+                mod->log_warn("checkpoint has unused data for this module");
+        } else {
+            mod->log_warn("no checkpoint data found for this module");
+        }
+    }
+
+    for (sc_object* child : obj->get_child_objects())
+        apply(child);
+}
+
+bool checkpoint::has_section(const string& name) const {
+    return m_sections.find(name) != m_sections.end();
+}
+
+u64 checkpoint::remaining() const {
+    if (m_section == nullptr || is_saving())
+        return 0;
+    return m_section->size - m_pos;
+}
+
+checkpoint::checkpoint(bool restoring):
+    m_restoring(restoring),
+    m_time(sc_time_stamp()),
+    m_file(),
+    m_sections(),
+    m_section(nullptr),
+    m_pos(0) {
+    // nothing to do
+}
+
+bool checkpoint::enter(const string& name) {
+    VCML_ERROR_ON(!m_file.is_open(), "checkpoint file not open");
+
+    finish_section();
+    m_pos = 0;
+
+    if (is_saving()) {
+        VCML_ERROR_ON(has_section(name), "duplicate section %s", name.c_str());
+        write_raw<u64>(m_file, name.length());
+        m_file.write(name.data(), name.length());
+        write_raw<u64>(m_file, 0);
+        m_section = &m_sections[name];
+        m_section->offset = m_file.tellp();
+        m_section->size = 0;
+        return true;
+    }
+
+    auto it = m_sections.find(name);
+    m_section = it != m_sections.end() ? &it->second : nullptr;
+    if (m_section != nullptr)
+        m_file.seekg(m_section->offset);
+    return m_section != nullptr;
+}
+
+void checkpoint::data(void* ptr, size_t size) {
+    VCML_ERROR_ON(!m_section, "no checkpoint section selected");
+
+    if (is_saving()) {
+        m_file.write((const char*)ptr, size);
+        VCML_ERROR_ON(!m_file.good(), "error writing checkpoint");
+    } else {
+        VCML_ERROR_ON(size > remaining(),
+                      "reading beyond end of checkpoint section");
+        m_file.read((char*)ptr, size);
+        VCML_ERROR_ON(!m_file.good(), "error reading checkpoint");
+    }
+
+    m_pos += size;
+}
+
+void checkpoint::value(string& str) {
+    u64 len = str.length();
+    value(len);
+    VCML_ERROR_ON(is_restoring() && len > remaining(),
+                  "checkpoint string length %llu out of bounds", len);
+    str.resize(len);
+    data(str.data(), len);
+}
+
+void checkpoint::write(const string& filename) {
+    VCML_ERROR_ON(m_restoring, "cannot write a restoring checkpoint");
+
+    if (m_file.is_open())
+        m_file.close();
+
+    m_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    VCML_ERROR_ON(!m_file.good(), "cannot open checkpoint file %s",
+                  filename.c_str());
+
+    m_time = sc_time_stamp();
+    m_sections.clear();
+
+    m_file.write(MAGIC, strlen(MAGIC));
+    write_raw<u32>(m_file, VERSION);
+    write_raw<u64>(m_file, m_time.value());
+    std::streampos count = m_file.tellp();
+    write_raw<u64>(m_file, 0);
+
+    for (sc_object* obj : sc_core::sc_get_top_level_objects())
+        capture(obj);
+    finish_section();
+
+    m_file.seekp(count);
+    write_raw<u64>(m_file, m_sections.size());
+
+    VCML_ERROR_ON(!m_file.good(), "error writing checkpoint %s",
+                  filename.c_str());
+    m_file.close();
+}
+
+void checkpoint::read(const string& filename) {
+    VCML_ERROR_ON(!m_restoring, "cannot read into a saving checkpoint");
+
+    if (m_file.is_open())
+        m_file.close();
+
+    m_file.open(filename, std::ios::in | std::ios::binary);
+    VCML_ERROR_ON(!m_file.good(), "cannot open checkpoint file %s",
+                  filename.c_str());
+
+    m_file.seekg(0, std::ios::end);
+    u64 filesize = m_file.tellg();
+    m_file.seekg(0, std::ios::beg);
+
+    string magic(strlen(MAGIC), '\0');
+    m_file.read(magic.data(), magic.length());
+    VCML_ERROR_ON(magic != MAGIC, "%s is not a checkpoint", filename.c_str());
+
+    u32 version = 0;
+    read_raw(m_file, version);
+    VCML_ERROR_ON(version != VERSION, "unsupported checkpoint version %u",
+                  version);
+
+    u64 time = 0;
+    read_raw(m_file, time);
+    m_time = time_from_value(time);
+
+    u64 count = 0;
+    read_raw(m_file, count);
+
+    // only index the sections here, their data is streamed during apply
+    m_sections.clear();
+    for (u64 i = 0; i < count; i++) {
+        u64 len = 0, size = 0;
+        read_raw(m_file, len);
+        VCML_ERROR_ON(!m_file.good() || len > bytes_left(m_file, filesize),
+                      "invalid section name length in %s", filename.c_str());
+        string name(len, '\0');
+        m_file.read(name.data(), len);
+
+        read_raw(m_file, size);
+        VCML_ERROR_ON(!m_file.good() || size > bytes_left(m_file, filesize),
+                      "invalid size of section %s in %s", name.c_str(),
+                      filename.c_str());
+
+        u64 offset = m_file.tellg();
+        m_sections[name] = { offset, size };
+        m_file.seekg(offset + size);
+    }
+
+    VCML_ERROR_ON(!m_file.good(), "error reading checkpoint %s",
+                  filename.c_str());
+    m_section = nullptr;
+    m_pos = 0;
+}
+
+void checkpoint::apply() {
+    VCML_ERROR_ON(!m_restoring, "cannot apply a saving checkpoint");
+
+    if (m_time != sc_time_stamp()) {
+        log_warn("restoring checkpoint from %s at %s",
+                 m_time.to_string().c_str(),
+                 sc_time_stamp().to_string().c_str());
+    }
+
+    for (sc_object* obj : sc_core::sc_get_top_level_objects())
+        apply(obj);
+    m_section = nullptr;
+}
+
+} // namespace vcml
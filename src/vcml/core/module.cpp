@@ -83,6 +83,21 @@ void module::session_resume() {
     // to be overloaded
 }
 
+void module::serialize(checkpoint& cp) {
+    for (sc_attr_base* attr : attr_cltn()) {
+        property_base* prop = dynamic_cast<property_base*>(attr);
+        if (prop == nullptr || !prop->is_checkpointed())
+            continue;
+
+        string name = prop->basename();
+        cp.value(name);
+        VCML_ERROR_ON(name != prop->basename(),
+                      "checkpoint expected %s but found %s", prop->basename(),
+                      name.c_str());
+        prop->serialize(cp);
+    }
+}
+
 bool module::execute(const string& name, const vector<string>& args,
                      ostream& os) {
     command_base* cmd = get_command(name);
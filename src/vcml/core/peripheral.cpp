@@ -13,6 +13,16 @@
 
 namespace vcml {
 
+// registers of one address space never overlap, so sorting them by start
+// address also sorts them by end address and allows binary searching
+static vector<reg_base*>::const_iterator find_register(
+    const vector<reg_base*>& regs, u64 addr) {
+    return std::lower_bound(regs.begin(), regs.end(), addr,
+                            [](const reg_base* reg, u64 val) -> bool {
+                                return reg->get_range().end < val;
+                            });
+}
+
 bool peripheral::cmd_mmap(const vector<string>& args, ostream& os) {
     os << "Memory map of " << name();
 #define HEX(x)                                                            \
@@ -35,16 +45,73 @@ bool peripheral::cmd_mmap(const vector<string>& args, ostream& os) {
     return true;
 }
 
+bool peripheral::cmd_regstats(const vector<string>& args, ostream& os) {
+    if (!args.empty() && args[0] == "reset") {
+        reset_regstats();
+        os << "register statistics reset";
+        return true;
+    }
+
+    if (!args.empty()) {
+        os << "unknown argument: " << args[0];
+        return false;
+    }
+
+    if (!profile_registers)
+        os << "register profiling disabled for " << name() << std::endl;
+
+    auto regs = get_registers();
+    std::stable_sort(regs.begin(), regs.end(), [](reg_base* a, reg_base* b) {
+        const reg_stats& sa = a->get_stats();
+        const reg_stats& sb = b->get_stats();
+        if (sa.total_ns() != sb.total_ns())
+            return sa.total_ns() > sb.total_ns();
+        return sa.num_accesses() > sb.num_accesses();
+    });
+
+    size_t width = 8;
+    for (const reg_base* reg : regs)
+        width = max(width, strlen(reg->basename()));
+
+    os << "Register statistics of " << name() << std::endl
+       << std::left << std::setw(width) << "register" << std::right
+       << std::setw(12) << "reads" << std::setw(12) << "writes"
+       << std::setw(14) << "bytes read" << std::setw(14) << "bytes written"
+       << std::setw(14) << "host ns" << std::setw(10) << "ns/access";
+
+    for (const reg_base* reg : regs) {
+        const reg_stats& st = reg->get_stats();
+        if (st.num_accesses() == 0)
+            continue;
+
+        os << std::endl
+           << std::left << std::setw(width) << reg->basename() << std::right
+           << std::setw(12) << st.num_reads << std::setw(12)
+           << st.num_writes << std::setw(14) << st.bytes_read
+           << std::setw(14) << st.bytes_written << std::setw(14)
+           << st.total_ns() << std::setw(10)
+           << st.total_ns() / st.num_accesses();
+    }
+
+    return true;
+}
+
 peripheral::peripheral(const sc_module_name& nm, endianess default_endian,
                        unsigned int rlatency, unsigned int wlatency):
     component(nm),
     m_current_cpu(SBI_NONE.cpuid),
     m_registers(),
+    m_regmap(),
     endian("endian", default_endian),
     read_latency("read_latency", rlatency),
-    write_latency("write_latency", wlatency) {
+    write_latency("write_latency", wlatency),
+    profile_registers("profile_registers", false) {
+    profile_registers.inherit_default();
     register_command("mmap", 0, &peripheral::cmd_mmap,
                      "shows the memory map of this peripheral");
+    register_command("regstats", 0, &peripheral::cmd_regstats,
+                     "shows register access statistics, use 'regstats "
+                     "reset' to clear them");
 }
 
 peripheral::~peripheral() {
@@ -58,19 +125,58 @@ void peripheral::reset() {
         r->reset();
 }
 
+void peripheral::reset_regstats() {
+    for (reg_base* reg : m_registers)
+        reg->reset_stats();
+}
+
+void peripheral::write_regstats_csv(ostream& os) const {
+    for (const reg_base* reg : m_registers) {
+        const reg_stats& st = reg->get_stats();
+        if (st.num_accesses() == 0)
+            continue;
+
+        os << name() << "," << reg->basename() << "," << reg->as << ","
+           << st.num_reads << "," << st.num_writes << "," << st.bytes_read
+           << "," << st.bytes_written << "," << st.read_ns << ","
+           << st.write_ns << std::endl;
+    }
+}
+
+static void collect_regstats(sc_object* obj, ostream& os) {
+    const peripheral* p = dynamic_cast<const peripheral*>(obj);
+    if (p != nullptr)
+        p->write_regstats_csv(os);
+
+    for (sc_object* child : obj->get_child_objects())
+        collect_regstats(child, os);
+}
+
+void peripheral::export_regstats(ostream& os) {
+    os << "peripheral,register,space,reads,writes,bytes_read,"
+          "bytes_written,read_ns,write_ns"
+       << std::endl;
+
+    for (sc_object* obj : sc_core::sc_get_top_level_objects())
+        collect_regstats(obj, os);
+}
+
 void peripheral::add_register(reg_base* reg) {
     if (stl_contains(m_registers, reg))
         VCML_ERROR("register %s already assigned", reg->name());
 
-    for (auto r : m_registers) {
-        if (r->get_range().overlaps(reg->get_range()) && reg->as == r->as)
-            VCML_ERROR(
-                "address space of register %s (%d: %s) already in "
-                "use by register %s",
-                reg->name(), reg->as, to_string(reg->get_range()).c_str(),
-                r->name());
+    vector<reg_base*>& regs = m_regmap[reg->as];
+    auto it = find_register(regs, reg->get_address());
+    if (it != regs.end() && (*it)->get_range().overlaps(reg->get_range())) {
+        VCML_ERROR(
+            "address space of register %s (%d: %s) already in "
+            "use by register %s",
+            reg->name(), reg->as, to_string(reg->get_range()).c_str(),
+            (*it)->name());
     }
 
+    regs.insert(it, reg);
+
     mwr::stl_insert_sorted(m_registers, reg,
                            [](const reg_base* a, const reg_base* b) -> bool {
                                return a->get_address() < b->get_address();
@@ -81,6 +187,7 @@ void peripheral::remove_register(reg_base* reg) {
     if (!stl_contains(m_registers, reg))
         VCML_ERROR("unknown register '%s'", reg->name());
     stl_remove(m_registers, reg);
+    stl_remove(m_regmap[reg->as], reg);
 }
 
 void peripheral::map_dmi(const tlm_dmi& dmi) {
@@ -116,7 +223,13 @@ unsigned int peripheral::transport(tlm_generic_payload& tx,
         swidth = length;
 
     unsigned int npulses = length / swidth;
-    for (unsigned int pulse = 0; pulse < npulses && !failed(tx); pulse++) {
+    const range pulse_addr(addr, addr + swidth - 1);
+    bool bulk = !be_ptr && npulses > 1 && is_memory_like(pulse_addr, as);
+    if (bulk)
+        nbytes = transport_streaming(tx, info, as);
+
+    for (unsigned int pulse = 0; !bulk && pulse < npulses && !failed(tx);
+         pulse++) {
         if (!info.is_debug) {
             local_time() += tx.is_read() ? clock_cycles(read_latency)
                                          : clock_cycles(write_latency);
@@ -128,17 +241,29 @@ unsigned int peripheral::transport(tlm_generic_payload& tx,
             tx.set_response_status(TLM_INCOMPLETE_RESPONSE);
             nbytes += receive(tx, info, as);
         } else {
-            for (unsigned int byte = 0; byte < swidth && !failed(tx); byte++) {
-                if (be_ptr[be_index++ % be_length]) {
-                    tx.set_address(addr + byte);
-                    tx.set_data_ptr(ptr + pulse * swidth + byte);
-                    tx.set_data_length(1);
-                    tx.set_streaming_width(1);
-                    tx.set_byte_enable_ptr(nullptr);
-                    tx.set_byte_enable_length(0);
-                    tx.set_response_status(TLM_INCOMPLETE_RESPONSE);
-                    nbytes += receive(tx, info, as);
+            // dispatch each run of contiguous enabled bytes at once
+            unsigned int byte = 0;
+            while (byte < swidth && !failed(tx)) {
+                if (!be_ptr[be_index++ % be_length]) {
+                    byte++;
+                    continue;
                 }
+
+                unsigned int first = byte++;
+                while (byte < swidth && be_ptr[be_index % be_length]) {
+                    be_index++;
+                    byte++;
+                }
+
+                unsigned int size = byte - first;
+                tx.set_address(addr + first);
+                tx.set_data_ptr(ptr + pulse * swidth + first);
+                tx.set_data_length(size);
+                tx.set_streaming_width(size);
+                tx.set_byte_enable_ptr(nullptr);
+                tx.set_byte_enable_length(0);
+                tx.set_response_status(TLM_INCOMPLETE_RESPONSE);
+                nbytes += receive(tx, info, as);
             }
         }
     }
@@ -160,6 +285,37 @@ unsigned int peripheral::transport(tlm_generic_payload& tx,
     return nbytes;
 }
 
+unsigned int peripheral::transport_streaming(tlm_generic_payload& tx,
+                                             const tlm_sbi& info,
+                                             address_space as) {
+    unsigned char* ptr = tx.get_data_ptr();
+    unsigned int length = tx.get_data_length();
+    unsigned int swidth = tx.get_streaming_width();
+    unsigned int npulses = length / swidth;
+
+    // memory-like regions have no side effects, so reading once and
+    // replicating the data or only performing the last write is sufficient
+    unsigned int pulse = tx.is_read() ? 0 : npulses - 1;
+    tx.set_data_ptr(ptr + pulse * swidth);
+    tx.set_data_length(swidth);
+    tx.set_response_status(TLM_INCOMPLETE_RESPONSE);
+    unsigned int nbytes = receive(tx, info, as);
+
+    if (failed(tx))
+        npulses = 1;
+    else if (tx.is_read()) {
+        for (pulse = 1; pulse < npulses; pulse++)
+            memcpy(ptr + pulse * swidth, ptr, swidth);
+    }
+
+    if (!info.is_debug) {
+        local_time() += tx.is_read() ? clock_cycles(read_latency) * npulses
+                                     : clock_cycles(write_latency) * npulses;
+    }
+
+    return nbytes * npulses;
+}
+
 unsigned int peripheral::receive(tlm_generic_payload& tx, const tlm_sbi& info,
                                  address_space as) {
     unsigned int bytes = 0;
@@ -179,8 +335,16 @@ unsigned int peripheral::receive(tlm_generic_payload& tx, const tlm_sbi& info,
 
     set_current_cpu(info.cpuid);
 
-    for (auto reg : m_registers)
-        if (reg->get_range().overlaps(tx) && reg->as == as) {
+    auto regs = m_regmap.find(as);
+    if (regs != m_regmap.end()) {
+        const range addr(tx);
+        auto end = regs->second.end();
+        for (auto it = find_register(regs->second, addr.start); it != end;
+             it++) {
+            reg_base* reg = *it;
+            if (reg->get_address() > addr.end)
+                break;
+
             bytes += reg->receive(tx, info);
 
             if (success(tx) && reg->is_natural_accesses_only())
@@ -189,6 +353,7 @@ unsigned int peripheral::receive(tlm_generic_payload& tx, const tlm_sbi& info,
             if (failed(tx))
                 break;
         }
+    }
 
     set_current_cpu(SBI_NONE.cpuid);
     if (success(tx) || failed(tx)) // stop if at least one reg took the access
@@ -207,6 +372,10 @@ unsigned int peripheral::receive(tlm_generic_payload& tx, const tlm_sbi& info,
     return tx.is_response_ok() ? addr.length() : 0;
 }
 
+bool peripheral::is_memory_like(const range& addr, address_space as) const {
+    return false; // to be overloaded
+}
+
 tlm_response_status peripheral::read(const range& addr, void* data,
                                      const tlm_sbi& info, address_space as) {
     return read(addr, data, info); // to be overloaded
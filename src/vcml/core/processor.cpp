@@ -46,6 +46,9 @@ bool processor::cmd_dump(const vector<string>& args, ostream& os) {
         }
     }
 
+    os << "Idle:" << std::endl
+       << "  " << m_idle_skips << " skips, " << m_idle_time << std::endl;
+
     return true;
 }
 
@@ -242,6 +245,48 @@ bool processor::cmd_gdb(const vector<string>& args, ostream& os) {
     return true;
 }
 
+void processor::set_idle(bool idle) {
+    if (!thctl_is_sysc_thread()) {
+        on_next_update([this, idle]() -> void { set_idle(idle); });
+        return;
+    }
+
+    m_idle = idle;
+    if (!idle)
+        m_wakeup.notify(SC_ZERO_TIME);
+}
+
+bool processor::is_irq_pending() const {
+    for (const auto& it : m_irq_stats) {
+        if (it.second.irq_status)
+            return true;
+    }
+
+    return false;
+}
+
+void processor::skip_idle() {
+    // an interrupt that is already pending wakes us up immediately
+    if (is_irq_pending()) {
+        m_idle = false;
+        return;
+    }
+
+    sync();
+
+    // instead of stepping through quanta, let the kernel jump straight to
+    // the next scheduled event and wait for an interrupt to wake us up
+    sc_time start = sc_time_stamp();
+    kernel_keep_alive(true);
+    while (m_idle && !is_irq_pending() && sim_running())
+        wait(m_wakeup);
+    kernel_keep_alive(false);
+    m_idle = false;
+
+    m_idle_skips++;
+    m_idle_time += sc_time_stamp() - start;
+}
+
 u64 processor::simulate_cycles(size_t cycles) {
     u64 count = cycle_count();
     double start = mwr::timestamp();
@@ -262,7 +307,9 @@ void processor::processor_thread() {
         // check for standby requests
         wait_clock_reset();
 
-        if (async && !is_stepping()) {
+        if (parallel && !is_stepping()) {
+            vcml::sc_async([&]() { running = processor_thread_parallel(); });
+        } else if (async && !is_stepping()) {
             vcml::sc_async([&]() { running = processor_thread_async(); });
         } else {
             running = processor_thread_sync();
@@ -280,7 +327,6 @@ bool processor::processor_thread_async() {
         log_warn("async_rate is larger than 10 - value: %u", async_rate.get());
 
     sc_time& lt = local_time();
-    const sc_time& quantum = tlm::tlm_global_quantum::instance().get();
 
     sc_progress(lt);
     lt = SC_ZERO_TIME;
@@ -289,6 +335,7 @@ bool processor::processor_thread_async() {
         if (!sim_running())
             return false;
 
+        const sc_time quantum = async_quantum();
         for (sc_time offset = async_time_offset(); offset < quantum;
              offset = async_time_offset()) {
             u64 step_size = (quantum / clock_cycle()) / async_rate;
@@ -311,8 +358,49 @@ bool processor::processor_thread_async() {
             lt = SC_ZERO_TIME;
         }
 
-        while (sim_running() && async_time_offset() >= quantum)
-            mwr::cpu_yield();
+        sc_async_wait([]() -> bool {
+            return async_time_offset() < async_quantum();
+        });
+    }
+}
+
+bool processor::processor_thread_parallel() {
+    sc_time& lt = local_time();
+
+    sc_progress(lt);
+    lt = SC_ZERO_TIME;
+
+    while (true) {
+        if (!sim_running())
+            return false;
+
+        // fall back to sequential simulation when single-stepping
+        if (is_stepping() || !is_running())
+            return true;
+
+        // all parallel processors execute the same global quantum window
+        const sc_time quantum = async_quantum();
+        VCML_ERROR_ON(quantum == SC_ZERO_TIME, "parallel mode needs a quantum");
+
+        const sc_time now = async_time_stamp();
+        const u64 q = quantum.value();
+        const sc_time window = time_from_value((now.value() / q + 1) * q);
+
+        u64 cycles = (window - now) / clock_cycle();
+        if (cycles > 0) {
+            simulate_cycles(cycles);
+            update_local_time(lt, current_process());
+            sc_progress(lt);
+            lt = SC_ZERO_TIME;
+        } else {
+            sc_progress(window - now);
+        }
+
+        // barrier: simulation time only reaches the end of the window once
+        // all other processors have completed it as well
+        sc_async_wait([]() -> bool {
+            return async_time_offset() == SC_ZERO_TIME;
+        });
     }
 }
 
@@ -322,6 +410,11 @@ bool processor::processor_thread_sync() {
         if (!sim_running())
             return false;
 
+        if (m_idle && idle_skip && !is_stepping()) {
+            skip_idle();
+            continue;
+        }
+
         unsigned int num_cycles = 1;
         sc_time quantum = tlm_global_quantum::instance().get();
         if (quantum > clock_cycle() && quantum > local_time()) {
@@ -358,6 +451,10 @@ processor::processor(const sc_module_name& nm, const string& cpuarch):
     target(),
     m_run_time(0),
     m_cycle_count(0),
+    m_idle(false),
+    m_idle_skips(0),
+    m_idle_time(),
+    m_wakeup("wakeup"),
     m_gdb(nullptr),
     m_irq_stats(),
     m_regprops(),
@@ -369,6 +466,8 @@ processor::processor(const sc_module_name& nm, const string& cpuarch):
     gdb_term("gdb_term", "gdbterm"),
     async("async", false),
     async_rate("async_rate", 5),
+    parallel("parallel", false),
+    idle_skip("idle_skip", false),
     irq("irq"),
     insn("insn"),
     data("data") {
@@ -422,6 +521,7 @@ void processor::reset() {
 
     m_cycle_count = 0;
     m_run_time = 0.0;
+    set_idle(false);
 
     for (auto reg : m_regprops)
         reg.second->reset();
@@ -434,6 +534,17 @@ void processor::session_suspend() {
     fetch_cpuregs();
 }
 
+void processor::serialize(checkpoint& cp) {
+    // cpu state is captured through the properties of all cpuregs
+    if (cp.is_saving())
+        fetch_cpuregs();
+
+    component::serialize(cp);
+
+    if (cp.is_restoring())
+        flush_cpuregs();
+}
+
 void processor::session_resume() {
     component::session_resume();
     flush_cpuregs();
@@ -489,6 +600,8 @@ void processor::gpio_notify(const gpio_target_socket& socket, bool state,
     if (state) {
         stats.irq_count++;
         stats.irq_last = sc_time_stamp();
+        report_quantum_activity(QUANTUM_ACTIVITY_IRQ);
+        set_idle(false);
     } else {
         sc_time delta = sc_time_stamp() - stats.irq_last;
         if (delta > stats.irq_longest)
@@ -530,6 +643,10 @@ void processor::end_of_elaboration() {
         stats.irq_longest = SC_ZERO_TIME;
     }
 
+    // idle periods are only skipped by the synchronous processor thread
+    if (idle_skip && (async || parallel))
+        log_warn("idle_skip has no effect with async or parallel");
+
     if (gdb_port >= 0) {
         auto run = gdb_wait ? debugging::GDB_STOPPED : debugging::GDB_RUNNING;
         m_gdb = new debugging::gdbserver(gdb_port, *this, run);
@@ -588,6 +705,7 @@ void processor::define_cpureg(size_t regno, const string& name, size_t size,
     auto*& prop = m_regprops[regno];
     VCML_ERROR_ON(prop, "property %s already exists", name.c_str());
     prop = new property<void>(name.c_str(), size, nelem, defval);
+    prop->set_checkpointed();
 }
 
 void processor::define_cpureg_r(size_t regno, const string& name, size_t size,
@@ -632,12 +750,60 @@ bool processor::write_cpureg_dbg(const debugging::cpureg& reg, const void* buf,
     return true;
 }
 
+static bool lookup_dmi_dbg(tlm_initiator_socket& socket, u64 addr,
+                           vcml_access acs, tlm_dmi& dmi) {
+    if (!socket.allow_dmi)
+        return false;
+
+    const range mem(addr, addr);
+    if (socket.dmi_cache().lookup(mem, acs, dmi))
+        return true;
+    if (!socket.lookup_dmi_ptr(mem, acs))
+        return false;
+    return socket.dmi_cache().lookup(mem, acs, dmi);
+}
+
+u64 processor::access_pmem_dbg(tlm_command cmd, u64 addr, void* buffer,
+                               u64 size) {
+    u8* ptr = (u8*)buffer;
+    u64 done = 0;
+
+    const vcml_access acs = cmd == TLM_READ_COMMAND ? VCML_ACCESS_READ
+                                                    : VCML_ACCESS_WRITE;
+
+    while (done < size) {
+        const u64 start = addr + done;
+        const u64 todo = size - done;
+
+        // copy everything that is covered by a DMI region at once
+        tlm_dmi dmi;
+        if (lookup_dmi_dbg(data, start, acs, dmi)) {
+            u64 n = min(todo - 1, (u64)dmi.get_end_address() - start) + 1;
+            u8* mem = dmi_get_ptr(dmi, start);
+            if (cmd == TLM_READ_COMMAND)
+                memcpy(ptr + done, mem, n);
+            else
+                memcpy(mem, ptr + done, n);
+            done += n;
+            continue;
+        }
+
+        // otherwise use debug transport up to the next page boundary
+        const u64 pgsz = 4 * KiB;
+        unsigned int n = min(todo, pgsz - start % pgsz);
+        if (!success(data.access(cmd, start, ptr + done, n, SBI_DEBUG)) &&
+            !success(insn.access(cmd, start, ptr + done, n, SBI_DEBUG)))
+            break;
+
+        done += n;
+    }
+
+    return done;
+}
+
 u64 processor::read_pmem_dbg(u64 addr, void* buffer, u64 size) {
     try {
-        if (success(data.read(addr, buffer, size, SBI_DEBUG)))
-            return size;
-        if (success(insn.read(addr, buffer, size, SBI_DEBUG)))
-            return size;
+        return access_pmem_dbg(TLM_READ_COMMAND, addr, buffer, size);
     } catch (report& r) {
         log_warn("error reading %llu bytes to memory at address 0x%llx: %s",
                  size, addr, r.message());
@@ -648,10 +814,8 @@ u64 processor::read_pmem_dbg(u64 addr, void* buffer, u64 size) {
 
 u64 processor::write_pmem_dbg(u64 addr, const void* buffer, u64 size) {
     try {
-        if (success(data.write(addr, buffer, size, SBI_DEBUG)))
-            return size;
-        if (success(insn.write(addr, buffer, size, SBI_DEBUG)))
-            return size;
+        void* ptr = const_cast<void*>(buffer);
+        return access_pmem_dbg(TLM_WRITE_COMMAND, addr, ptr, size);
     } catch (report& r) {
         log_warn("error writing %llu bytes to memory at address 0x%llx: %s",
                  size, addr, r.message());
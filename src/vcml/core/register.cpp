@@ -8,6 +8,8 @@
  *                                                                            *
  ******************************************************************************/
 
+#include <chrono>
+
 #include "vcml/core/register.h"
 #include "vcml/core/peripheral.h"
 
@@ -31,6 +33,7 @@ reg_base::reg_base(address_space space, const string& regname, u64 addr,
     m_secure(0),
     m_privilege(0),
     m_host(hierarchy_search<peripheral>()),
+    m_stats(),
     as(space),
     tag() {
     VCML_ERROR_ON(m_cell_size == 0, "register cell size cannot be 0");
@@ -67,19 +70,52 @@ void reg_base::do_receive(tlm_generic_payload& tx, const tlm_sbi& info) {
         }
     }
 
+    const range addr(tx);
     unsigned char* ptr = tx.get_data_ptr();
-    if (m_host->endian != host_endian()) // i.e. if big endian
-        memswap(ptr, tx.get_data_length());
+    if (m_host->endian == host_endian()) {
+        if (tx.is_read())
+            do_read(addr, ptr);
+        if (tx.is_write())
+            do_write(addr, ptr);
+    } else {
+        if (tx.is_read())
+            do_read_swapped(addr, ptr);
+        if (tx.is_write())
+            do_write_swapped(addr, ptr);
+    }
 
-    if (tx.is_read())
-        do_read(tx, ptr);
-    if (tx.is_write())
-        do_write(tx, ptr);
+    tx.set_response_status(TLM_OK_RESPONSE);
+}
 
-    if (m_host->endian != host_endian()) // i.e. swap back
-        memswap(ptr, tx.get_data_length());
+void reg_base::do_receive_profiled(tlm_generic_payload& tx,
+                                   const tlm_sbi& info) {
+    auto t0 = std::chrono::steady_clock::now();
+    do_receive(tx, info);
+    auto t1 = std::chrono::steady_clock::now();
+    u64 ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0)
+                 .count();
+
+    u64 bytes = tx.is_response_ok() ? tx.get_data_length() : 0;
+    if (tx.is_read()) {
+        m_stats.num_reads++;
+        m_stats.bytes_read += bytes;
+        m_stats.read_ns += ns;
+    } else if (tx.is_write()) {
+        m_stats.num_writes++;
+        m_stats.bytes_written += bytes;
+        m_stats.write_ns += ns;
+    }
+}
 
-    tx.set_response_status(TLM_OK_RESPONSE);
+void reg_base::do_read_swapped(const range& addr, void* ptr) {
+    do_read(addr, ptr);
+    memswap(ptr, addr.length());
+}
+
+void reg_base::do_write_swapped(const range& addr, void* ptr) {
+    memswap(ptr, addr.length());
+    do_write(addr, ptr);
+    memswap(ptr, addr.length()); // swap back
 }
 
 unsigned int reg_base::receive(tlm_generic_payload& tx, const tlm_sbi& info) {
@@ -105,14 +141,17 @@ unsigned int reg_base::receive(tlm_generic_payload& tx, const tlm_sbi& info) {
     tx.set_data_length(span.length());
 
     if (!info.is_debug) {
-        if (tx.is_read() && m_rsync)
-            m_host->sync();
-        if (tx.is_write() && m_wsync)
+        if ((tx.is_read() && m_rsync) || (tx.is_write() && m_wsync)) {
+            report_quantum_activity(QUANTUM_ACTIVITY_SYNC);
             m_host->sync();
+        }
     }
 
     m_host->trace_fw(*this, tx, m_host->local_time());
-    do_receive(tx, info);
+    if (m_host->is_profiling_registers())
+        do_receive_profiled(tx, info);
+    else
+        do_receive(tx, info);
     m_host->trace_bw(*this, tx, m_host->local_time());
 
     tx.set_address(addr);
@@ -41,6 +41,42 @@ void system::timeout() {
     }
 }
 
+void system::write_regstats() {
+    if (regstats.get().empty())
+        return;
+
+    std::ofstream os(regstats.get());
+    if (!os.good()) {
+        log_warn("cannot write register statistics to %s", regstats.c_str());
+        return;
+    }
+
+    peripheral::export_regstats(os);
+    log_info("register statistics written to %s", regstats.c_str());
+}
+
+bool system::cmd_checkpoint(const vector<string>& args, ostream& os) {
+    try {
+        save_checkpoint(args[0]);
+        os << "checkpoint written to " << args[0];
+        return true;
+    } catch (std::exception& ex) {
+        os << "error writing checkpoint: " << ex.what();
+        return false;
+    }
+}
+
+bool system::cmd_restore(const vector<string>& args, ostream& os) {
+    try {
+        load_checkpoint(args[0]);
+        os << "checkpoint restored from " << args[0];
+        return true;
+    } catch (std::exception& ex) {
+        os << "error restoring checkpoint: " << ex.what();
+        return false;
+    }
+}
+
 system::system(const sc_module_name& nm):
     module(nm),
     name("name", mwr::progname()),
@@ -50,7 +86,10 @@ system::system(const sc_module_name& nm):
     session("session", -1),
     session_debug("session_debug", false),
     quantum("quantum", sc_time(1, SC_US)),
-    duration("duration", SC_ZERO_TIME) {
+    duration("duration", SC_ZERO_TIME),
+    profile_registers("profile_registers", false),
+    regstats("regstats", ""),
+    restore("restore", "") {
     if (backtrace)
         mwr::report_segfaults();
 
@@ -59,6 +98,11 @@ system::system(const sc_module_name& nm):
 
     if (config.get().empty())
         log_warn("no configuration specified, use -f <config>");
+
+    register_command("checkpoint", 1, &system::cmd_checkpoint,
+                     "stores the simulation state into <file>");
+    register_command("restore", 1, &system::cmd_restore,
+                     "restores the simulation state from <file>");
 }
 
 system::~system() {
@@ -102,7 +146,28 @@ int system::run() {
         return EXIT_FAILURE;
     }
 
+    write_regstats();
     return EXIT_SUCCESS;
 }
 
+void system::save_checkpoint(const string& filename) {
+    checkpoint cp(false);
+    cp.write(filename);
+}
+
+void system::load_checkpoint(const string& filename) {
+    checkpoint cp(true);
+    cp.read(filename);
+    cp.apply();
+}
+
+void system::start_of_simulation() {
+    module::start_of_simulation();
+
+    if (!restore.get().empty()) {
+        load_checkpoint(restore);
+        log_info("restored checkpoint %s", restore.c_str());
+    }
+}
+
 } // namespace vcml
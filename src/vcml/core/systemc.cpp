@@ -211,6 +211,139 @@ bool kernel_has_phase_callbacks() {
 #endif
 }
 
+static void async_wake_all();
+
+// hierarchical timing wheel: level n holds all timers whose timeout first
+// differs from the current wheel time in digit n, so all timers on a lower
+// level expire before those on any higher level
+class timer_wheel
+{
+public:
+    typedef async_timer::event event;
+
+    static constexpr size_t SLOT_BITS = 6;
+    static constexpr size_t NUM_SLOTS = 1ull << SLOT_BITS;
+    static constexpr size_t NUM_LEVELS = (64 + SLOT_BITS - 1) / SLOT_BITS;
+    static constexpr size_t NO_SLOT = ~(size_t)0;
+
+private:
+    u64 m_now;
+    size_t m_size;
+    u64 m_used[NUM_LEVELS];
+    event* m_slots[NUM_LEVELS * NUM_SLOTS];
+
+    size_t slot_of(u64 timeout) const {
+        if (timeout <= m_now) // overdue, expires with the next advance
+            return m_now % NUM_SLOTS;
+        size_t level = fls(timeout ^ m_now) / SLOT_BITS;
+        u64 digit = (timeout >> (level * SLOT_BITS)) % NUM_SLOTS;
+        return level * NUM_SLOTS + digit;
+    }
+
+    u64 slot_start(size_t slot) const {
+        size_t shift = (slot / NUM_SLOTS) * SLOT_BITS;
+        size_t upper = shift + SLOT_BITS;
+        u64 base = upper < 64 ? (m_now >> upper) << upper : 0;
+        return base | (u64)(slot % NUM_SLOTS) << shift;
+    }
+
+    size_t first_slot() const {
+        for (size_t level = 0; level < NUM_LEVELS; level++) {
+            if (m_used[level])
+                return level * NUM_SLOTS + ctz(m_used[level]);
+        }
+
+        return NO_SLOT;
+    }
+
+    event* detach(size_t slot) {
+        event* head = m_slots[slot];
+        m_slots[slot] = nullptr;
+        m_used[slot / NUM_SLOTS] &= ~(1ull << (slot % NUM_SLOTS));
+        return head;
+    }
+
+public:
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+
+    timer_wheel(): m_now(0), m_size(0), m_used(), m_slots() {}
+
+    ~timer_wheel() {
+        for (size_t slot = 0; slot < NUM_LEVELS * NUM_SLOTS; slot++) {
+            for (event* ev = m_slots[slot]; ev != nullptr;) {
+                event* next = ev->next;
+                delete ev;
+                ev = next;
+            }
+        }
+    }
+
+    void insert(event* ev) {
+        size_t slot = slot_of(ev->timeout.value());
+        ev->slot = slot;
+        ev->prev = nullptr;
+        ev->next = m_slots[slot];
+        if (ev->next)
+            ev->next->prev = ev;
+        m_slots[slot] = ev;
+        m_used[slot / NUM_SLOTS] |= 1ull << (slot % NUM_SLOTS);
+        m_size++;
+    }
+
+    void remove(event* ev) {
+        if (ev->prev)
+            ev->prev->next = ev->next;
+        else
+            m_slots[ev->slot] = ev->next;
+        if (ev->next)
+            ev->next->prev = ev->prev;
+        if (m_slots[ev->slot] == nullptr)
+            detach(ev->slot);
+
+        ev->prev = ev->next = nullptr;
+        ev->slot = NO_SLOT;
+        m_size--;
+    }
+
+    u64 next_timeout() const {
+        size_t slot = first_slot();
+        u64 timeout = ~0ull;
+        for (event* ev = m_slots[slot]; ev != nullptr; ev = ev->next)
+            timeout = std::min<u64>(timeout, ev->timeout.value());
+        return timeout;
+    }
+
+    // moves wheel time forward to t, collecting all timers that expired on
+    // the way; timers of a reached slot are cascaded down to lower levels
+    void advance(u64 t, vector<event*>& expired) {
+        while (m_size > 0) {
+            size_t slot = first_slot();
+            u64 start = slot_start(slot);
+            if (start > t)
+                break;
+
+            m_now = start;
+            for (event* ev = detach(slot); ev != nullptr;) {
+                event* next = ev->next;
+                ev->prev = ev->next = nullptr;
+                ev->slot = NO_SLOT;
+                m_size--;
+
+                if (ev->timeout.value() <= t)
+                    expired.push_back(ev);
+                else
+                    insert(ev);
+
+                ev = next;
+            }
+        }
+
+        if (m_now < t)
+            m_now = t;
+    }
+};
+
 // we just need this class to have something that is called every cycle...
 class helper_module : public sc_core::sc_trace_file,
                       public sc_core::sc_prim_channel
@@ -281,44 +414,52 @@ public:
     vector<function<void(void)>> deltas;
     vector<function<void(void)>> tsteps;
 
-    struct timer_compare {
-        inline bool operator()(const async_timer::event* a,
-                               const async_timer::event* b) const {
-            return a->timeout > b->timeout;
-        }
-    };
+    size_t keep_alive;
 
-    sc_event timeout_event;
-    priority_queue<async_timer::event*, vector<async_timer::event*>,
-                   timer_compare>
-        timers;
-
-    vector<async_timer::event*> pending_timers() {
-        lock_guard<mutex> guard(mtx);
-        vector<async_timer::event*> pending;
-        sc_time now = sc_time_stamp();
-
-        while (!timers.empty()) {
-            async_timer::event* event = timers.top();
-            if (event->timeout > now)
-                break;
+    void set_keep_alive(bool keep) {
+        VCML_ERROR_ON(!keep && keep_alive == 0, "unbalanced keep alive");
+#if SYSTEMC_VERSION >= SYSTEMC_VERSION_2_3_2
+        if (keep && keep_alive == 0)
+            async_attach_suspending();
+        if (!keep && keep_alive == 1)
+            async_detach_suspending();
+#endif
+        keep_alive = keep ? keep_alive + 1 : keep_alive - 1;
+    }
 
-            timers.pop();
-            pending.push_back(event);
+    sc_event timeout_event;
+    timer_wheel timers; // only accessed from the systemc thread
+    atomic<async_timer::event*> incoming;
+
+    // moves timers added from other threads into the wheel; the incoming
+    // stack hands out the most recent timer first, so restore fifo order
+    void drain_timers() {
+        async_timer::event* head = incoming.exchange(nullptr);
+        async_timer::event* list = nullptr;
+        while (head != nullptr) {
+            async_timer::event* next = head->next;
+            head->next = list;
+            list = head;
+            head = next;
         }
 
-        return pending;
+        while (list != nullptr) {
+            async_timer::event* next = list->next;
+            if (list->owner)
+                timers.insert(list);
+            else
+                delete list; // cancelled before it reached the wheel
+            list = next;
+        }
     }
 
     void update_timer() {
-        lock_guard<mutex> guard(mtx);
-
         if (timers.empty()) {
             timeout_event.cancel();
             return;
         }
 
-        sc_time next_timeout = timers.top()->timeout;
+        sc_time next_timeout = time_from_value(timers.next_timeout());
         if (next_timeout < sc_time_stamp())
             timeout_event.notify(SC_ZERO_TIME);
         else
@@ -326,10 +467,12 @@ public:
     }
 
     void run_timer() {
-        vector<async_timer::event*> pending = pending_timers();
-        for (auto event : pending) {
-            if (event->owner)
-                event->owner->trigger();
+        vector<async_timer::event*> expired;
+        timers.advance(sc_time_stamp().value(), expired);
+        for (auto event : expired) {
+            async_timer* owner = event->owner;
+            if (owner)
+                owner->trigger();
             delete event;
         }
 
@@ -337,12 +480,30 @@ public:
     }
 
     void add_timer(async_timer::event* ev) {
-        lock_guard<mutex> guard(mtx);
-        timers.push(ev);
+        if (thctl_is_sysc_thread()) {
+            timers.insert(ev);
+        } else {
+            if (!sc_is_async())
+                report_quantum_activity(QUANTUM_ACTIVITY_ASYNC);
+            ev->next = incoming.load();
+            while (!incoming.compare_exchange_weak(ev->next, ev))
+                ; // retry
+        }
+
         async_request_update();
     }
 
+    void cancel_timer(async_timer::event* ev) {
+        // events still queued or about to expire are freed by their owners
+        if (ev->slot == timer_wheel::NO_SLOT)
+            return;
+
+        timers.remove(ev);
+        delete ev;
+    }
+
     void update() override {
+        drain_timers();
         update_timer();
 
         vector<function<void(void)>> curr_update;
@@ -368,8 +529,10 @@ public:
         end_of_sim(),
         deltas(),
         tsteps(),
+        keep_alive(0),
         timeout_event("timeout_ev"),
-        timers() {
+        timers(),
+        incoming(nullptr) {
 #if SYSTEMC_VERSION >= SYSTEMC_VERSION_2_3_1a
         if (use_phase_callbacks) {
             register_simulation_phase_callback(sc_core::SC_END_OF_UPDATE |
@@ -407,9 +570,10 @@ public:
         if (!use_phase_callbacks)
             sc_get_curr_simcontext()->remove_trace_file(this);
 #endif
-        while (!timers.empty()) {
-            delete timers.top();
-            timers.pop();
+        for (auto* ev = incoming.exchange(nullptr); ev != nullptr;) {
+            auto* next = ev->next;
+            delete ev;
+            ev = next;
         }
     }
 
@@ -443,6 +607,7 @@ protected:
 
     virtual void end_of_simulation() override {
         sim_running = false;
+        async_wake_all();
 
         for (auto& func : end_of_sim)
             func();
@@ -454,6 +619,9 @@ protected:
 helper_module& g_helper = helper_module::instance();
 
 void on_next_update(function<void(void)> callback) {
+    if (!thctl_is_sysc_thread() && !sc_is_async())
+        report_quantum_activity(QUANTUM_ACTIVITY_ASYNC);
+
     helper_module& helper = helper_module::instance();
     lock_guard<mutex> guard(helper.mtx);
     helper.next_update.push_back(std::move(callback));
@@ -501,6 +669,8 @@ void async_timer::trigger() {
 void async_timer::cancel() {
     if (m_event) {
         m_event->owner = nullptr;
+        if (thctl_is_sysc_thread())
+            g_helper.cancel_timer(m_event);
         m_event = nullptr;
     }
 }
@@ -508,15 +678,23 @@ void async_timer::cancel() {
 void async_timer::reset(const sc_time& delta) {
     cancel();
 
-    m_event = new event;
-    m_event->owner = this;
-    m_event->timeout = m_timeout = sc_time_stamp() + delta;
-
+    m_timeout = sc_time_stamp() + delta;
+    m_event = new event(this, m_timeout);
     g_helper.add_timer(m_event);
 }
 
 thread_local struct async_worker* g_async = nullptr;
 
+static atomic<size_t> g_async_spin_limit(1000);
+
+void set_async_spin_limit(size_t iterations) {
+    g_async_spin_limit = iterations;
+}
+
+size_t async_spin_limit() {
+    return g_async_spin_limit;
+}
+
 struct async_worker {
     const size_t id;
     sc_process_b* const process;
@@ -528,12 +706,23 @@ struct async_worker {
     atomic<u64> progress;
     atomic<function<void(void)>*> request;
 
+    // time the async thread has progressed to and the time its systemc
+    // thread has reached, so async threads never read kernel state
+    atomic<u64> target;
+    atomic<u64> reached;
+
+    // global quantum as seen by the systemc thread, since it may change
+    // while the async thread is running
+    atomic<u64> quantum;
+
+    atomic<bool> sleeping;
+    mutex wake_mtx;
+    condition_variable wake;
+
     mutex mtx;
     condition_variable_any notify;
     thread worker;
 
-    sc_time sc_thread_pos;
-
     struct sim_terminated_exception {};
 
     async_worker(size_t worker_id, sc_process_b* worker_proc):
@@ -544,10 +733,15 @@ struct async_worker {
         task(),
         progress(0),
         request(nullptr),
+        target(sc_time_stamp().value()),
+        reached(sc_time_stamp().value()),
+        quantum(tlm_global_quantum::instance().get().value()),
+        sleeping(false),
+        wake_mtx(),
+        wake(),
         mtx(),
         notify(),
-        worker(&async_worker::work, this),
-        sc_thread_pos(sc_time_stamp()) {
+        worker(&async_worker::work, this) {
         VCML_ERROR_ON(!process, "invalid parent process");
         mwr::set_thread_name(worker, mkstr("vcml_async:%zu", id));
     }
@@ -556,6 +750,7 @@ struct async_worker {
         if (worker.joinable()) {
             alive = false;
             notify.notify_all();
+            wake_up();
             worker.join();
         }
     }
@@ -585,27 +780,33 @@ struct async_worker {
         g_async = nullptr;
     }
 
+    void advance(u64 p) {
+        sc_core::wait(time_from_value(p));
+        quantum = tlm_global_quantum::instance().get().value();
+        reached = sc_time_stamp().value();
+    }
+
     void run_async(function<void(void)>& job) {
         mtx.lock();
         task = job;
+        target = reached = sc_time_stamp().value();
+        quantum = tlm_global_quantum::instance().get().value();
         working = true;
         mtx.unlock();
         notify.notify_one();
 
         while (working) {
-            u64 p = progress.exchange(0);
-            sc_thread_pos = sc_time_stamp() + time_from_value(p);
-            sc_core::wait(time_from_value(p));
+            advance(progress.exchange(0));
+            wake_up();
 
             if (request) {
-                p = progress.exchange(0);
-                if (p > 0) {
-                    sc_thread_pos = sc_time_stamp() + time_from_value(p);
-                    sc_core::wait(time_from_value(p));
-                }
+                u64 p = progress.exchange(0);
+                if (p > 0)
+                    advance(p);
 
                 (*request)();
                 request = nullptr;
+                wake_up();
             }
         }
 
@@ -614,23 +815,67 @@ struct async_worker {
             sc_core::wait(time_from_value(p));
     }
 
-    void run_sync(function<void(void)> job) {
-        g_async->request = &job;
-        while (g_async->request) {
-            if (!sim_running())
-                throw sim_terminated_exception();
+    // spin briefly for low handoff latency, then sleep until the SystemC
+    // thread either advances time, finishes a pending request or ends the
+    // simulation; cond must only depend on state published before a wake_up
+    template <typename COND>
+    void block_until(const COND& cond) {
+        const size_t limit = g_async_spin_limit;
+        for (size_t i = 0; i < limit && alive; i++) {
+            if (cond())
+                return;
             mwr::cpu_yield();
         }
+
+        std::unique_lock<mutex> lock(wake_mtx);
+        sleeping = true;
+        while (alive && !cond())
+            wake.wait(lock);
+        sleeping = false;
+
+        if (!alive)
+            throw sim_terminated_exception();
     }
 
-    sc_time timestamp() { return sc_thread_pos + time_from_value(progress); }
+    // sleeping is set before cond is checked, so either the async thread
+    // observes the new state or we observe it sleeping and notify
+    void wake_up() {
+        if (sleeping) {
+            lock_guard<mutex> guard(wake_mtx);
+            wake.notify_all();
+        }
+    }
+
+    void run_sync(function<void(void)> job) {
+        request = &job;
+        block_until([&]() -> bool { return !request || !sim_running(); });
+        if (request)
+            throw sim_terminated_exception();
+    }
+
+    void run_wait(const function<bool(void)>& cond) {
+        block_until([&]() -> bool { return !sim_running() || cond(); });
+    }
+
+    sc_time timestamp() const { return time_from_value(target); }
+
+    sc_time offset() const {
+        u64 now = reached;
+        u64 pos = target;
+        return time_from_value(pos > now ? pos - now : 0);
+    }
+
+    typedef unordered_map<sc_process_b*, shared_ptr<async_worker>> map;
+
+    static map& workers() {
+        static map instance;
+        return instance;
+    }
 
     static async_worker& lookup(sc_process_b* thread) {
         VCML_ERROR_ON(!thread, "invalid thread");
 
-        typedef unordered_map<sc_process_b*, shared_ptr<async_worker>> map;
-        static map workers;
-
+        map& workers = async_worker::workers();
         auto it = workers.find(thread);
         if (it != workers.end())
             return *it->second;
@@ -641,6 +886,11 @@ struct async_worker {
     }
 };
 
+static void async_wake_all() {
+    for (auto& it : async_worker::workers())
+        it.second->wake_up();
+}
+
 void sc_async(function<void(void)> job) {
     auto thread = current_thread();
     VCML_ERROR_ON(!thread, "sc_async must be called from SC_THREAD");
@@ -650,6 +900,7 @@ void sc_async(function<void(void)> job) {
 
 void sc_progress(const sc_time& delta) {
     VCML_ERROR_ON(!g_async, "no async thread to progress");
+    g_async->target += delta.value();
     g_async->progress += delta.value();
 }
 
@@ -663,6 +914,26 @@ void sc_sync(function<void(void)> job) {
     }
 }
 
+void sc_async_wait(const function<bool(void)>& cond) {
+    VCML_ERROR_ON(!g_async, "no async thread to wait");
+    g_async->run_wait(cond);
+}
+
+void kernel_keep_alive(bool keep) {
+    VCML_ERROR_ON(!thctl_is_sysc_thread(), "not on systemc thread");
+    helper_module::instance().set_keep_alive(keep);
+}
+
+static atomic<u64> g_quantum_activity[NUM_QUANTUM_ACTIVITIES];
+
+void report_quantum_activity(quantum_activity kind) {
+    g_quantum_activity[kind].fetch_add(1, std::memory_order_relaxed);
+}
+
+u64 quantum_activity_count(quantum_activity kind) {
+    return g_quantum_activity[kind].load(std::memory_order_relaxed);
+}
+
 bool sc_is_async() {
     return g_async != nullptr;
 }
@@ -673,8 +944,16 @@ sc_time async_time_stamp() {
     return sc_time_stamp();
 }
 
+sc_time async_quantum() {
+    if (sc_is_async())
+        return time_from_value(g_async->quantum);
+    return tlm_global_quantum::instance().get();
+}
+
 sc_time async_time_offset() {
-    return async_time_stamp() - sc_time_stamp();
+    if (sc_is_async())
+        return g_async->offset();
+    return SC_ZERO_TIME;
 }
 
 bool is_thread(sc_process_b* proc) {
@@ -719,6 +998,116 @@ sc_process_b* current_method() {
     return proc;
 }
 
+// process indices are stored as an attribute of each process, processes
+// usually carry no other attributes, so finding it is a single comparison
+static const string PROCESS_INDEX_ATTR = "vcml_process_index";
+
+struct process_index_attr : public sc_core::sc_attr_base {
+    size_t index;
+    u64 serial;
+
+    process_index_attr(size_t idx, u64 ser):
+        sc_core::sc_attr_base(PROCESS_INDEX_ATTR), index(idx), serial(ser) {}
+};
+
+// indices are only handed out to processes that reach a tlm_host; dynamic
+// processes are held until they terminate so that their index can be
+// reused, terminated ones are collected when the live set has doubled
+class process_indexer
+{
+private:
+    struct dynamic_proc {
+        sc_core::sc_process_handle handle;
+        process_index_attr* attr;
+    };
+
+    mutex m_lock;
+    size_t m_next;
+    u64 m_serial;
+    vector<size_t> m_free;
+    vector<dynamic_proc> m_dynamic;
+    size_t m_sweep;
+
+    void sweep() {
+        auto it = m_dynamic.begin();
+        while (it != m_dynamic.end()) {
+            if (!it->handle.terminated()) {
+                it++;
+                continue;
+            }
+
+            it->handle.get_process_object()->remove_attribute(
+                PROCESS_INDEX_ATTR);
+            m_free.push_back(it->attr->index);
+            delete it->attr;
+            it = m_dynamic.erase(it);
+        }
+
+        m_sweep = max<size_t>(16, 2 * m_dynamic.size());
+    }
+
+public:
+    process_indexer():
+        m_lock(), m_next(1), m_serial(0), m_free(), m_dynamic(), m_sweep(16) {
+    }
+
+    const process_index_attr* assign(sc_process_b* proc) {
+        lock_guard<mutex> guard(m_lock);
+        sc_core::sc_attr_base* attr = proc->get_attribute(PROCESS_INDEX_ATTR);
+        if (attr != nullptr)
+            return static_cast<process_index_attr*>(attr);
+
+        if (m_free.empty() && m_dynamic.size() >= m_sweep)
+            sweep();
+
+        size_t idx = m_next;
+        if (m_free.empty())
+            m_next++;
+        else {
+            idx = m_free.back();
+            m_free.pop_back();
+        }
+
+        process_index_attr* pia = new process_index_attr(idx, ++m_serial);
+        proc->add_attribute(*pia);
+
+        sc_core::sc_process_handle handle(proc);
+        if (handle.dynamic())
+            m_dynamic.push_back({ handle, pia });
+
+        return pia;
+    }
+
+    static process_indexer& instance() {
+        static process_indexer indexer;
+        return indexer;
+    }
+};
+
+static const process_index_attr* lookup_process_index(sc_process_b* proc) {
+    sc_core::sc_attr_base* attr = proc->get_attribute(PROCESS_INDEX_ATTR);
+    if (attr != nullptr)
+        return static_cast<process_index_attr*>(attr);
+    return process_indexer::instance().assign(proc);
+}
+
+size_t process_index(sc_process_b* proc) {
+    if (proc == nullptr)
+        return 0;
+    return lookup_process_index(proc)->index;
+}
+
+size_t process_index(sc_process_b* proc, u64& serial) {
+    if (proc == nullptr) {
+        serial = 0;
+        return 0;
+    }
+
+    const process_index_attr* attr = lookup_process_index(proc);
+    serial = attr->serial;
+    return attr->index;
+}
+
 bool is_stop_requested() {
     return sc_core::sc_get_simulator_status() == sc_core::SC_SIM_USER_STOP;
 }
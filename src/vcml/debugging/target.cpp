@@ -144,11 +144,21 @@ u64 target::read_vmem_dbg(u64 addr, void* buffer, u64 size) {
     while (addr < end) {
         u64 pa = 0;
         u64 todo = min(end - addr, pgsz - (addr % pgsz));
-        if (virt_to_phys(addr, pa))
-            count += read_pmem_dbg(pa, dest, todo);
-        else
-            memset(buffer, 0xee, todo);
+        if (!virt_to_phys(addr, pa)) {
+            memset(dest, 0xee, todo);
+            addr += todo;
+            dest += todo;
+            continue;
+        }
+
+        // merge all following pages that are also physically contiguous
+        u64 pnext = 0;
+        while (addr + todo < end && virt_to_phys(addr + todo, pnext) &&
+               pnext == pa + todo) {
+            todo += min(end - addr - todo, pgsz);
+        }
 
+        count += read_pmem_dbg(pa, dest, todo);
         addr += todo;
         dest += todo;
     }
@@ -163,16 +173,23 @@ u64 target::write_vmem_dbg(u64 addr, const void* buffer, u64 size) {
 
     u64 count = 0;
     u64 end = addr + size;
-    const u8* dest = (const u8*)buffer;
+    const u8* src = (const u8*)buffer;
 
     while (addr < end) {
         u64 pa = 0;
         u64 todo = min(end - addr, pgsz - (addr % pgsz));
-        if (virt_to_phys(addr, pa))
-            count += write_pmem_dbg(pa, dest, todo);
+        if (virt_to_phys(addr, pa)) {
+            u64 pnext = 0;
+            while (addr + todo < end && virt_to_phys(addr + todo, pnext) &&
+                   pnext == pa + todo) {
+                todo += min(end - addr - todo, pgsz);
+            }
+
+            count += write_pmem_dbg(pa, src, todo);
+        }
 
         addr += todo;
-        dest += todo;
+        src += todo;
     }
 
     return count;
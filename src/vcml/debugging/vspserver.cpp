@@ -12,6 +12,7 @@
 #include "vcml/core/systemc.h"
 #include "vcml/core/version.h"
 #include "vcml/core/component.h"
+#include "vcml/core/system.h"
 
 #include "vcml/debugging/vspserver.h"
 #include "vcml/debugging/target.h"
@@ -336,6 +337,38 @@ string vspserver::handle_seta(const string& cmd) {
     return "OK";
 }
 
+string vspserver::handle_save(const string& cmd) {
+    if (is_running())
+        return "E,simulation running";
+
+    vector<string> args = split(cmd, ',');
+    if (args.size() < 2)
+        return mkstr("E,insufficient arguments %zu", args.size());
+
+    try {
+        system::save_checkpoint(args[1]);
+        return "OK";
+    } catch (std::exception& e) {
+        return mkstr("E,%s", escape(e.what(), ",").c_str());
+    }
+}
+
+string vspserver::handle_load(const string& cmd) {
+    if (is_running())
+        return "E,simulation running";
+
+    vector<string> args = split(cmd, ',');
+    if (args.size() < 2)
+        return mkstr("E,insufficient arguments %zu", args.size());
+
+    try {
+        system::load_checkpoint(args[1]);
+        return "OK";
+    } catch (std::exception& e) {
+        return mkstr("E,%s", escape(e.what(), ",").c_str());
+    }
+}
+
 string vspserver::handle_mkbp(const string& cmd) {
     if (is_running())
         return "E,simulation running";
@@ -454,6 +487,8 @@ vspserver::vspserver(u16 server_port):
     register_handler("seta", &vspserver::handle_seta);
     register_handler("mkbp", &vspserver::handle_mkbp);
     register_handler("rmbp", &vspserver::handle_rmbp);
+    register_handler("checkpoint", &vspserver::handle_save);
+    register_handler("restore", &vspserver::handle_load);
 
     // Create announce file
     ofstream of(m_announce.c_str());
@@ -463,11 +463,11 @@ gic400::distif::distif(const sc_module_name& nm):
 
     ctlr.sync_on_write();
     ctlr.allow_read_write();
-    ctlr.on_write(&distif::write_ctlr);
+    ctlr.on_write<&distif::write_ctlr>();
 
     typer.sync_never();
     typer.allow_read_only();
-    typer.on_read(&distif::read_typer);
+    typer.on_read<&distif::read_typer>();
 
     iidr.sync_never();
     iidr.allow_read_only();
@@ -475,70 +475,70 @@ gic400::distif::distif(const sc_module_name& nm):
     igroupr.set_banked();
     igroupr.sync_on_write();
     igroupr.allow_read_write();
-    igroupr.on_read(&distif::read_igroupr);
-    igroupr.on_write(&distif::write_igroupr);
+    igroupr.on_read<&distif::read_igroupr>();
+    igroupr.on_write<&distif::write_igroupr>();
 
     isenabler_ppi.set_banked();
     isenabler_ppi.sync_always();
     isenabler_ppi.allow_read_write();
-    isenabler_ppi.on_read(&distif::read_isenabler_ppi);
-    isenabler_ppi.on_write(&distif::write_isenabler_ppi);
+    isenabler_ppi.on_read<&distif::read_isenabler_ppi>();
+    isenabler_ppi.on_write<&distif::write_isenabler_ppi>();
 
     isenabler_spi.sync_always();
     isenabler_spi.allow_read_write();
-    isenabler_spi.on_read(&distif::read_isenabler_spi);
-    isenabler_spi.on_write(&distif::write_isenabler_spi);
+    isenabler_spi.on_read<&distif::read_isenabler_spi>();
+    isenabler_spi.on_write<&distif::write_isenabler_spi>();
 
     icenabler_ppi.set_banked();
     icenabler_ppi.sync_always();
     icenabler_ppi.allow_read_write();
-    icenabler_ppi.on_read(&distif::read_icenabler_ppi);
-    icenabler_ppi.on_write(&distif::write_icenabler_ppi);
+    icenabler_ppi.on_read<&distif::read_icenabler_ppi>();
+    icenabler_ppi.on_write<&distif::write_icenabler_ppi>();
 
     icenabler_spi.sync_always();
     icenabler_spi.allow_read_write();
-    icenabler_spi.on_read(&distif::read_icenabler_spi);
-    icenabler_spi.on_write(&distif::write_icenabler_spi);
+    icenabler_spi.on_read<&distif::read_icenabler_spi>();
+    icenabler_spi.on_write<&distif::write_icenabler_spi>();
 
     ispendr_ppi.set_banked();
     ispendr_ppi.sync_always();
     ispendr_ppi.allow_read_write();
-    ispendr_ppi.on_read(&distif::read_ispendr_ppi);
-    ispendr_ppi.on_write(&distif::write_ispendr_ppi);
+    ispendr_ppi.on_read<&distif::read_ispendr_ppi>();
+    ispendr_ppi.on_write<&distif::write_ispendr_ppi>();
 
     ispendr_spi.sync_always();
     ispendr_spi.allow_read_write();
-    ispendr_spi.on_read(&distif::read_sspr);
-    ispendr_spi.on_write(&distif::write_sspr);
+    ispendr_spi.on_read<&distif::read_sspr>();
+    ispendr_spi.on_write<&distif::write_sspr>();
 
     icpendr_ppi.set_banked();
     icpendr_ppi.sync_always();
     icpendr_ppi.allow_read_write();
-    icpendr_ppi.on_read(&distif::read_icpendr_ppi);
-    icpendr_ppi.on_write(&distif::write_icpendr_ppi);
+    icpendr_ppi.on_read<&distif::read_icpendr_ppi>();
+    icpendr_ppi.on_write<&distif::write_icpendr_ppi>();
 
     icpendr_spi.sync_always();
     icpendr_spi.allow_read_write();
-    icpendr_spi.on_read(&distif::read_icpendr_spi);
-    icpendr_spi.on_write(&distif::write_icpendr_spi);
+    icpendr_spi.on_read<&distif::read_icpendr_spi>();
+    icpendr_spi.on_write<&distif::write_icpendr_spi>();
 
     isactiver_ppi.set_banked();
     isactiver_ppi.allow_read_only();
     isactiver_ppi.sync_on_read();
-    isactiver_ppi.on_read(&distif::read_isactiver_ppi);
+    isactiver_ppi.on_read<&distif::read_isactiver_ppi>();
 
     isactiver_spi.allow_read_only();
     isactiver_spi.sync_on_read();
-    isactiver_spi.on_read(&distif::read_isactiver_spi);
+    isactiver_spi.on_read<&distif::read_isactiver_spi>();
 
     icactiver_ppi.set_banked();
     icactiver_ppi.sync_on_write();
     icactiver_ppi.allow_read_write();
-    icactiver_ppi.on_write(&distif::write_icactiver_ppi);
+    icactiver_ppi.on_write<&distif::write_icactiver_ppi>();
 
     icactiver_spi.sync_on_write();
     icactiver_spi.allow_read_write();
-    icactiver_spi.on_write(&distif::write_icactiver_spi);
+    icactiver_spi.on_write<&distif::write_icactiver_spi>();
 
     ipriority_sgi.set_banked();
     ipriority_sgi.sync_never();
@@ -554,7 +554,7 @@ gic400::distif::distif(const sc_module_name& nm):
     itargets_ppi.set_banked();
     itargets_ppi.sync_always();
     itargets_ppi.allow_read_write();
-    itargets_ppi.on_read(&distif::read_itargets_ppi);
+    itargets_ppi.on_read<&distif::read_itargets_ppi>();
 
     itargets_spi.sync_always();
     itargets_spi.allow_read_write();
@@ -564,26 +564,26 @@ gic400::distif::distif(const sc_module_name& nm):
 
     icfgr_ppi.sync_on_write();
     icfgr_ppi.allow_read_write();
-    icfgr_ppi.on_write(&distif::write_icfgr);
+    icfgr_ppi.on_write<&distif::write_icfgr>();
 
     icfgr_spi.sync_on_write();
     icfgr_spi.allow_read_write();
-    icfgr_spi.on_write(&distif::write_icfgr_spi);
+    icfgr_spi.on_write<&distif::write_icfgr_spi>();
 
     sgir.set_banked();
     sgir.allow_write_only();
     sgir.sync_on_write();
-    sgir.on_write(&distif::write_sgir);
+    sgir.on_write<&distif::write_sgir>();
 
     spendsgir.set_banked();
     spendsgir.sync_always();
     spendsgir.allow_read_write();
-    spendsgir.on_write(&distif::write_spendsgir);
+    spendsgir.on_write<&distif::write_spendsgir>();
 
     cpendsgir.set_banked();
     cpendsgir.sync_always();
     cpendsgir.allow_read_write();
-    cpendsgir.on_write(&distif::write_cpendsgir);
+    cpendsgir.on_write<&distif::write_cpendsgir>();
 
     cidr.allow_read_only();
     cidr.sync_never();
@@ -780,7 +780,7 @@ gic400::cpuif::cpuif(const sc_module_name& nm):
     ctlr.set_banked();
     ctlr.sync_always();
     ctlr.allow_read_write();
-    ctlr.on_write(&cpuif::write_ctlr);
+    ctlr.on_write<&cpuif::write_ctlr>();
 
     pmr.set_banked();
     pmr.sync_always();
@@ -790,17 +790,17 @@ gic400::cpuif::cpuif(const sc_module_name& nm):
     bpr.set_banked();
     bpr.sync_always();
     bpr.allow_read_write();
-    bpr.on_write(&cpuif::write_bpr);
+    bpr.on_write<&cpuif::write_bpr>();
 
     iar.set_banked();
     iar.allow_read_only();
     iar.sync_on_read();
-    iar.on_read(&cpuif::read_iar<false>);
+    iar.on_read<&cpuif::read_iar<false>>();
 
     eoir.set_banked();
     eoir.allow_write_only();
     eoir.sync_on_write();
-    eoir.on_write(&cpuif::write_eoir<false>);
+    eoir.on_write<&cpuif::write_eoir<false>>();
 
     rpr.set_banked();
     rpr.sync_never();
@@ -813,7 +813,7 @@ gic400::cpuif::cpuif(const sc_module_name& nm):
     abpr.set_banked();
     abpr.sync_always();
     abpr.allow_read_write();
-    abpr.on_write(&cpuif::write_abpr);
+    abpr.on_write<&cpuif::write_abpr>();
 
     apr.sync_always();
     apr.allow_read_write();
@@ -821,12 +821,12 @@ gic400::cpuif::cpuif(const sc_module_name& nm):
     aiar.set_banked();
     aiar.allow_read_only();
     aiar.sync_on_read();
-    aiar.on_read(&cpuif::read_iar<true>);
+    aiar.on_read<&cpuif::read_iar<true>>();
 
     aeoir.set_banked();
     aeoir.allow_write_only();
     aeoir.sync_on_write();
-    aeoir.on_write(&cpuif::write_eoir<true>);
+    aeoir.on_write<&cpuif::write_eoir<true>>();
 
     ahppir.set_banked();
     ahppir.sync_never();
@@ -995,23 +995,23 @@ gic400::vifctrl::vifctrl(const sc_module_name& nm):
     in("in") {
     hcr.set_banked();
     hcr.allow_read_write();
-    hcr.on_write(&vifctrl::write_hcr);
+    hcr.on_write<&vifctrl::write_hcr>();
 
     vtr.allow_read_only();
-    vtr.on_read(&vifctrl::read_vtr);
+    vtr.on_read<&vifctrl::read_vtr>();
 
     lr.set_banked();
     lr.allow_read_write();
-    lr.on_write(&vifctrl::write_lr);
-    lr.on_read(&vifctrl::read_lr);
+    lr.on_write<&vifctrl::write_lr>();
+    lr.on_read<&vifctrl::read_lr>();
 
     vmcr.allow_read_write();
-    vmcr.on_read(&vifctrl::read_vmcr);
-    vmcr.on_write(&vifctrl::write_vmcr);
+    vmcr.on_read<&vifctrl::read_vmcr>();
+    vmcr.on_write<&vifctrl::write_vmcr>();
 
     apr.set_banked();
     apr.allow_read_write();
-    apr.on_write(&vifctrl::write_apr);
+    apr.on_write<&vifctrl::write_apr>();
 }
 
 gic400::vifctrl::~vifctrl() {
@@ -1140,22 +1140,22 @@ gic400::vcpuif::vcpuif(const sc_module_name& nm, class vifctrl* ctrl):
     in("in") {
     ctlr.set_banked();
     ctlr.allow_read_write();
-    ctlr.on_write(&vcpuif::write_ctlr);
+    ctlr.on_write<&vcpuif::write_ctlr>();
 
     pmr.set_banked();
     pmr.allow_read_write();
 
     bpr.set_banked();
     bpr.allow_read_write();
-    bpr.on_write(&vcpuif::write_bpr);
+    bpr.on_write<&vcpuif::write_bpr>();
 
     iar.set_banked();
     iar.allow_read_only();
-    iar.on_read(&vcpuif::read_iar<false>);
+    iar.on_read<&vcpuif::read_iar<false>>();
 
     eoir.set_banked();
     eoir.allow_write_only();
-    eoir.on_write(&vcpuif::write_eoir<false>);
+    eoir.on_write<&vcpuif::write_eoir<false>>();
 
     rpr.set_banked();
 
@@ -1164,15 +1164,15 @@ gic400::vcpuif::vcpuif(const sc_module_name& nm, class vifctrl* ctrl):
 
     abpr.set_banked();
     abpr.allow_read_write();
-    abpr.on_write(&vcpuif::write_abpr);
+    abpr.on_write<&vcpuif::write_abpr>();
 
     aiar.set_banked();
     aiar.allow_read_only();
-    aiar.on_read(&vcpuif::read_iar<true>);
+    aiar.on_read<&vcpuif::read_iar<true>>();
 
     aeoir.set_banked();
     aeoir.allow_write_only();
-    aeoir.on_write(&vcpuif::write_eoir<true>);
+    aeoir.on_write<&vcpuif::write_eoir<true>>();
 
     ahppir.set_banked();
     ahppir.allow_read_write();
@@ -9,6 +9,7 @@
  ******************************************************************************/
 
 #include "vcml/models/block/disk.h"
+#include "vcml/models/block/backend_ram.h"
 
 namespace vcml {
 namespace block {
@@ -48,6 +49,16 @@ bool disk::cmd_save_image(const vector<string>& args, ostream& os) {
     }
 }
 
+void disk::mark_dirty(size_t pos, size_t size) {
+    if (size == 0)
+        return;
+
+    size_t first = pos / DIRTY_BLOCK_SIZE;
+    size_t last = (pos + size - 1) / DIRTY_BLOCK_SIZE;
+    for (size_t blk = first; blk <= last; blk++)
+        m_dirty.insert(blk);
+}
+
 static string default_serial() {
     static size_t n = 0;
     return mkstr("vcml-disk-%zu", n++);
@@ -56,6 +67,7 @@ static string default_serial() {
 disk::disk(const sc_module_name& nm, const string& img, bool ro):
     module(nm),
     m_backend(nullptr),
+    m_dirty(),
     stats(),
     image("image", img),
     serial("serial", default_serial()),
@@ -129,6 +141,7 @@ bool disk::write(const u8* buffer, size_t size) {
     if (m_backend) {
         try {
             if (!m_backend->readonly()) {
+                mark_dirty(m_backend->pos(), size);
                 m_backend->write(buffer, size);
                 stats.num_bytes_written += size;
             }
@@ -150,6 +163,7 @@ bool disk::wzero(size_t size, bool may_unmap) {
     if (m_backend) {
         try {
             if (!m_backend->readonly()) {
+                mark_dirty(m_backend->pos(), size);
                 m_backend->wzero(size, may_unmap);
                 stats.num_bytes_written += size;
             }
@@ -170,6 +184,7 @@ bool disk::discard(size_t size) {
 
     if (m_backend) {
         try {
+            mark_dirty(m_backend->pos(), size);
             m_backend->discard(size);
             return true;
         } catch (std::exception& ex) {
@@ -200,5 +215,63 @@ bool disk::flush() {
     return false;
 }
 
+void disk::serialize(checkpoint& cp) {
+    module::serialize(cp);
+
+    // only blocks modified since elaboration are stored in checkpoints, so
+    // the image must still hold its initial contents when restoring; this
+    // only holds for ramdisks, writable images are modified in place
+    bool ramdisk = dynamic_cast<backend_ram*>(m_backend) != nullptr;
+    VCML_ERROR_ON(m_backend && !ramdisk && !m_backend->readonly(),
+                  "cannot checkpoint writable disk image %s", image.c_str());
+
+    u64 offset = pos();
+    u64 count = m_dirty.size();
+    cp.value(offset);
+    cp.value(count);
+
+    if (count > 0 && !m_backend)
+        VCML_ERROR("cannot checkpoint disk without backend");
+
+    vector<u8> buffer;
+    if (cp.is_saving()) {
+        for (size_t blk : m_dirty) {
+            u64 addr = blk * DIRTY_BLOCK_SIZE;
+            buffer.resize(min<size_t>(DIRTY_BLOCK_SIZE, capacity() - addr));
+            m_backend->seek(addr);
+            m_backend->read(buffer.data(), buffer.size());
+            cp.value(addr);
+            cp.value(buffer);
+        }
+    } else {
+        std::set<size_t> modified;
+        m_dirty.swap(modified);
+        for (u64 i = 0; i < count; i++) {
+            u64 addr = 0;
+            cp.value(addr);
+            cp.value(buffer);
+            VCML_ERROR_ON(addr + buffer.size() > capacity(),
+                          "checkpoint block 0x%llx out of bounds", addr);
+            m_backend->seek(addr);
+            m_backend->write(buffer.data(), buffer.size());
+            mark_dirty(addr, buffer.size());
+        }
+
+        // blocks written after the checkpoint revert to the zeroed ramdisk
+        for (size_t blk : modified) {
+            if (m_dirty.count(blk))
+                continue;
+
+            u64 addr = blk * DIRTY_BLOCK_SIZE;
+            m_backend->seek(addr);
+            m_backend->wzero(min<size_t>(DIRTY_BLOCK_SIZE, capacity() - addr),
+                             true);
+        }
+    }
+
+    if (m_backend)
+        m_backend->seek(offset);
+}
+
 } // namespace block
 } // namespace vcml
@@ -494,13 +494,13 @@ void lan9118_mac::write_mii_acc(u32 val) {
     u64 addr = extract(val, 6, 5);
     auto cmd = wnr ? TLM_WRITE_COMMAND : TLM_READ_COMMAND;
 
-    tlm_generic_payload tx;
+    tlm_pooled_payload tx;
     tlm_sbi sbi = in_debug_transaction() ? SBI_DEBUG : SBI_NONE;
-    tx_setup(tx, cmd, addr * size, &data, size);
-    u32 res = m_parent.phy.receive(tx, sbi, VCML_AS_DEFAULT);
+    tx_setup(*tx, cmd, addr * size, &data, size);
+    u32 res = m_parent.phy.receive(*tx, sbi, VCML_AS_DEFAULT);
 
-    if (failed(tx) || res != size)
-        log_warn("PHY CSR access failed %s", to_string(tx).c_str());
+    if (failed(*tx) || res != size)
+        log_warn("PHY CSR access failed %s", to_string(*tx).c_str());
     else if (!wnr)
         mii_data = data;
 }
@@ -1074,14 +1074,14 @@ void lan9118::write_mac_cmd(u32 val) {
     u32 addr = val & MAC_CMD_ADDR;
     auto cmd = val & MAC_CMD_R_NW ? TLM_READ_COMMAND : TLM_WRITE_COMMAND;
 
-    tlm_generic_payload tx;
+    tlm_pooled_payload tx;
     tlm_sbi sbi = in_debug_transaction() ? SBI_DEBUG : SBI_NONE;
-    tx_setup(tx, cmd, addr * size, &data, size);
-    u32 res = mac.receive(tx, sbi, VCML_AS_DEFAULT);
+    tx_setup(*tx, cmd, addr * size, &data, size);
+    u32 res = mac.receive(*tx, sbi, VCML_AS_DEFAULT);
 
-    if (failed(tx) || res != size)
-        log_warn("MAC CSR access failed %s", to_string(tx).c_str());
-    else if (tx.is_read())
+    if (failed(*tx) || res != size)
+        log_warn("MAC CSR access failed %s", to_string(*tx).c_str());
+    else if (tx->is_read())
         mac_csr_data = data;
 
     m_rxev.notify();
@@ -0,0 +1,172 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/models/generic/adaptive_quantum.h"
+#include "vcml/core/processor.h"
+
+namespace vcml {
+namespace generic {
+
+SC_HAS_PROCESS(adaptive_quantum);
+
+bool adaptive_quantum::has_parallel_processors(sc_object* obj) const {
+    processor* cpu = dynamic_cast<processor*>(obj);
+    if (cpu && cpu->parallel)
+        return true;
+
+    const auto& children = obj ? obj->get_child_objects()
+                               : sc_core::sc_get_top_level_objects();
+    for (sc_object* child : children) {
+        if (has_parallel_processors(child))
+            return true;
+    }
+
+    return false;
+}
+
+bool adaptive_quantum::is_tracked(quantum_activity kind) const {
+    switch (kind) {
+    case QUANTUM_ACTIVITY_IRQ:
+        return track_irq;
+    case QUANTUM_ACTIVITY_SYNC:
+        return track_sync;
+    case QUANTUM_ACTIVITY_ASYNC:
+        return track_async;
+    default:
+        return false;
+    }
+}
+
+u64 adaptive_quantum::collect_activity() {
+    u64 total = 0;
+    for (size_t i = 0; i < NUM_QUANTUM_ACTIVITIES; i++) {
+        quantum_activity kind = (quantum_activity)i;
+        u64 count = quantum_activity_count(kind);
+        m_delta[i] = count - m_last[i];
+        m_last[i] = count;
+        if (is_tracked(kind))
+            total += m_delta[i];
+    }
+
+    return total;
+}
+
+sc_time adaptive_quantum::next_quantum(const sc_time& curr, u64 activity) const {
+    sc_time next;
+    if (activity > threshold)
+        next = curr * shrink.get();
+    else if (policy.get() == "aimd")
+        next = curr + min_quantum.get() * grow.get();
+    else
+        next = curr * grow.get();
+
+    if (next < min_quantum)
+        next = min_quantum;
+    if (next > max_quantum)
+        next = max_quantum;
+    return next;
+}
+
+void adaptive_quantum::log_sample(const sc_time& next) {
+    if (!m_log.is_open())
+        return;
+
+    m_log << time_to_ns(sc_time_stamp()) << ","
+          << time_to_ns(current()) << "," << time_to_ns(next);
+    for (u64 delta : m_delta)
+        m_log << "," << delta;
+    m_log << std::endl;
+}
+
+void adaptive_quantum::control() {
+    while (!m_disabled) {
+        sc_time curr = current();
+        wait(curr * (double)interval);
+
+        sc_time next = next_quantum(curr, collect_activity());
+        log_sample(next);
+
+        if (next != curr) {
+            log_debug("quantum %s -> %s", curr.to_string().c_str(),
+                      next.to_string().c_str());
+            tlm_global_quantum::instance().set(next);
+            m_adjustments++;
+        }
+    }
+}
+
+adaptive_quantum::adaptive_quantum(const sc_module_name& nm):
+    module(nm),
+    m_last(),
+    m_delta(),
+    m_adjustments(0),
+    m_disabled(false),
+    m_log(),
+    min_quantum("min_quantum", sc_time(1, SC_US)),
+    max_quantum("max_quantum", sc_time(1, SC_MS)),
+    policy("policy", "mimd"),
+    grow("grow", 2.0),
+    shrink("shrink", 0.25),
+    interval("interval", 10),
+    threshold("threshold", 0),
+    track_irq("track_irq", true),
+    track_sync("track_sync", true),
+    track_async("track_async", true),
+    logfile("logfile", "") {
+    SC_THREAD(control);
+}
+
+adaptive_quantum::~adaptive_quantum() {
+    // nothing to do
+}
+
+void adaptive_quantum::end_of_elaboration() {
+    module::end_of_elaboration();
+
+    VCML_ERROR_ON(min_quantum == SC_ZERO_TIME, "min_quantum cannot be zero");
+    VCML_ERROR_ON(min_quantum > max_quantum, "min_quantum above max_quantum");
+    VCML_ERROR_ON(policy.get() != "mimd" && policy.get() != "aimd",
+                  "unknown quantum policy: %s", policy.c_str());
+    VCML_ERROR_ON(shrink <= 0.0 || shrink > 1.0, "shrink must be in (0, 1]");
+    VCML_ERROR_ON(policy.get() == "mimd" && grow < 1.0, "grow must be >= 1");
+    VCML_ERROR_ON(interval == 0u, "interval cannot be zero");
+
+    sc_time init = current();
+    if (init < min_quantum || init > max_quantum) {
+        init = init < min_quantum ? min_quantum : max_quantum;
+        tlm_global_quantum::instance().set(init);
+    }
+
+    // parallel processors must all execute the same quantum window, which
+    // cannot be guaranteed if the quantum changes while they are running
+    if (has_parallel_processors(nullptr)) {
+        log_warn("parallel processors found, quantum remains fixed");
+        m_disabled = true;
+        return;
+    }
+
+    for (size_t i = 0; i < NUM_QUANTUM_ACTIVITIES; i++)
+        m_last[i] = quantum_activity_count((quantum_activity)i);
+
+    if (!logfile.get().empty()) {
+        m_log.open(logfile.get());
+        if (m_log.good())
+            m_log << "time_ns,quantum_ns,next_ns,irq,sync,async" << std::endl;
+        else
+            log_warn("cannot open quantum log %s", logfile.c_str());
+    }
+}
+
+VCML_EXPORT_MODEL(vcml::generic::adaptive_quantum, name, args) {
+    return new adaptive_quantum(name);
+}
+
+} // namespace generic
+} // namespace vcml
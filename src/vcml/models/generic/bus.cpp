@@ -19,6 +19,39 @@ bool bus::mapping::operator<(const mapping& m) const {
     return addr.start < m.addr.start;
 }
 
+size_t bus::decoder::depth() const {
+    size_t depth = 0;
+    for (size_t n = entries.size(); n > 0; n >>= 1)
+        depth++;
+    return depth;
+}
+
+bool bus::decoder::overlaps(const range& addr) const {
+    auto it = std::upper_bound(entries.begin(), entries.end(), addr.end,
+                               [](u64 end, const mapping* m) -> bool {
+                                   return end < m->addr.start;
+                               });
+
+    if (it == entries.begin())
+        return false;
+
+    const mapping* m = *(--it);
+    return m->addr.overlaps(addr);
+}
+
+const bus::mapping* bus::decoder::find(const range& addr) const {
+    auto it = std::upper_bound(entries.begin(), entries.end(), addr.start,
+                               [](u64 start, const mapping* m) -> bool {
+                                   return start < m->addr.start;
+                               });
+
+    if (it == entries.begin())
+        return nullptr;
+
+    const mapping* m = *(--it);
+    return m->addr.includes(addr) ? m : nullptr;
+}
+
 size_t bus::find_target_port(sc_object& peer) const {
     for (const auto& it : m_target_peers)
         if (it.second == &peer)
@@ -71,23 +104,150 @@ bool bus::cmd_mmap(const vector<string>& args, ostream& os) {
     if (m_default.target != TARGET_NONE)
         os << "\ndefault route -> " << target_peer_name(m_default.target);
 
+    if (m_stale)
+        build_decoders();
+
+    os << "\ndecode depth: " << m_decoder.depth() << " ("
+       << m_decoder.entries.size() << " mappings)";
+
+    for (size_t port = 0; port < m_source_decoders.size(); port++) {
+        const decoder& dec = m_source_decoders[port];
+        if (dec.entries.empty())
+            continue;
+
+        os << "\ndecode depth via " << source_peer_name(port) << ": "
+           << dec.depth() << " (" << dec.entries.size() << " mappings)";
+    }
+
     return true;
 }
 
-const bus::mapping& bus::lookup(tlm_target_socket& s, const range& mem) const {
-    size_t port = in.index_of(s);
+bool bus::cmd_routes(const vector<string>& args, ostream& os) {
+    stream_guard guard(os);
+    os << "Route cache statistics of " << name();
 
-    for (const auto& m : m_mappings) {
-        if (m.addr.includes(mem) && m.source == port)
-            return m;
+    for (size_t port = 0; port < m_route_caches.size(); port++) {
+        const route_cache& cache = m_route_caches[port];
+        u64 total = cache.hits + cache.misses;
+        if (total == 0)
+            continue;
+
+        os << "\n" << port << ": " << source_peer_name(port) << ": "
+           << cache.hits << " hits, " << cache.misses << " misses ("
+           << std::fixed << std::setprecision(1)
+           << 100.0 * cache.hits / total << "% hit rate)";
     }
 
-    for (const auto& m : m_mappings) {
-        if (m.addr.includes(mem) && m.source == SOURCE_ANY)
-            return m;
+    return true;
+}
+
+u64 bus::route_hits(size_t port) const {
+    return port < m_route_caches.size() ? m_route_caches[port].hits : 0;
+}
+
+u64 bus::route_misses(size_t port) const {
+    return port < m_route_caches.size() ? m_route_caches[port].misses : 0;
+}
+
+void bus::build_decoders() {
+    m_stale = false;
+    m_decoder.entries.clear();
+    m_source_decoders.clear();
+
+    // m_mappings is sorted by start address and mappings of the same source
+    // never overlap, so each decoder ends up sorted and free of overlaps
+    for (const mapping& m : m_mappings) {
+        if (m.source == SOURCE_ANY) {
+            m_decoder.entries.push_back(&m);
+            continue;
+        }
+
+        if (m.source >= m_source_decoders.size())
+            m_source_decoders.resize(m.source + 1);
+        m_source_decoders[m.source].entries.push_back(&m);
+    }
+
+    flush_routes();
+}
+
+void bus::update_decoders() {
+    // during construction decoders are only built once mappings are final
+    m_stale = true;
+    if (m_elaborated)
+        build_decoders();
+}
+
+void bus::flush_routes() {
+    for (route_cache& cache : m_route_caches) {
+        for (route& r : cache.routes)
+            r.target = nullptr;
     }
+}
 
-    return m_default;
+void bus::invalidate_mapping(const mapping& m) {
+    for (auto& it : in) {
+        if (m.source == SOURCE_ANY || it.first == m.source)
+            (*it.second)->invalidate_direct_mem_ptr(m.addr.start, m.addr.end);
+    }
+}
+
+bool bus::is_uniform(size_t port, const mapping& m, const range& pg) const {
+    // a page may only be memorized if every address inside of it decodes to
+    // the same mapping, i.e. no other mapping with higher priority overlaps
+    if (!m.addr.includes(pg))
+        return false;
+
+    if (m.source != SOURCE_ANY)
+        return true;
+
+    if (port < m_source_decoders.size() &&
+        m_source_decoders[port].overlaps(pg))
+        return false;
+
+    if (&m == &m_default && m_decoder.overlaps(pg))
+        return false;
+
+    return true;
+}
+
+const bus::mapping& bus::decode(size_t port, const range& mem) {
+    if (m_stale)
+        build_decoders();
+
+    if (port < m_source_decoders.size()) {
+        const mapping* m = m_source_decoders[port].find(mem);
+        if (m != nullptr)
+            return *m;
+    }
+
+    const mapping* m = m_decoder.find(mem);
+    return m ? *m : m_default;
+}
+
+const bus::mapping& bus::lookup(tlm_target_socket& s, const range& mem) {
+    size_t port = in.index_of(s);
+    if (port >= m_route_caches.size())
+        m_route_caches.resize(port + 1);
+
+    route_cache& cache = m_route_caches[port];
+    u64 page = mem.start >> ROUTE_PAGE_BITS;
+    route& r = cache.routes[page % ROUTE_CACHE_SIZE];
+    if (r.target && r.page == page && (mem.end >> ROUTE_PAGE_BITS) == page) {
+        cache.hits++;
+        return *r.target;
+    }
+
+    cache.misses++;
+
+    const mapping& m = decode(port, mem);
+    range pg(page << ROUTE_PAGE_BITS,
+             (page << ROUTE_PAGE_BITS) | bitmask(ROUTE_PAGE_BITS));
+    if (is_uniform(port, m, pg)) {
+        r.page = page;
+        r.target = &m;
+    }
+
+    return m;
 }
 
 void bus::handle_bus_error(tlm_generic_payload& tx) const {
@@ -124,6 +284,8 @@ void bus::map(size_t target, const range& addr, u64 offset, size_t source) {
     m.addr = addr;
     m.offset = offset;
     m_mappings.insert(m);
+
+    update_decoders();
 }
 
 void bus::map_default(size_t target, u64 offset) {
@@ -134,6 +296,57 @@ void bus::map_default(size_t target, u64 offset) {
 
     m_default.target = target;
     m_default.offset = offset;
+
+    flush_routes();
+}
+
+void bus::unmap(size_t target) {
+    vector<mapping> removed;
+    for (auto it = m_mappings.begin(); it != m_mappings.end();) {
+        if (it->target == target) {
+            removed.push_back(*it);
+            it = m_mappings.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    if (m_default.target == target) {
+        removed.push_back(m_default);
+        m_default.target = TARGET_NONE;
+        m_default.offset = 0;
+    }
+
+    update_decoders();
+
+    for (const mapping& m : removed)
+        invalidate_mapping(m);
+}
+
+void bus::unmap(size_t target, const range& addr) {
+    vector<mapping> removed;
+    for (auto it = m_mappings.begin(); it != m_mappings.end();) {
+        if (it->target == target && it->addr == addr) {
+            removed.push_back(*it);
+            it = m_mappings.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    VCML_ERROR_ON(removed.empty(), "no mapping for %zu:0x%llx..0x%llx",
+                  target, addr.start, addr.end);
+
+    update_decoders();
+
+    for (const mapping& m : removed)
+        invalidate_mapping(m);
+}
+
+void bus::end_of_elaboration() {
+    component::end_of_elaboration();
+    m_elaborated = true;
+    build_decoders();
 }
 
 void bus::b_transport(tlm_target_socket& socket, tlm_generic_payload& tx,
@@ -152,7 +365,8 @@ void bus::b_transport(tlm_target_socket& socket, tlm_generic_payload& tx,
 
 unsigned int bus::transport_dbg(tlm_target_socket& origin,
                                 tlm_generic_payload& tx) {
-    const mapping& m = lookup(origin, tx);
+    // debug accesses may come from other threads and bypass the route cache
+    const mapping& m = decode(in.index_of(origin), tx);
     if (m.target == TARGET_NONE) {
         handle_bus_error(tx);
         return 0;
@@ -167,7 +381,7 @@ unsigned int bus::transport_dbg(tlm_target_socket& origin,
 
 bool bus::get_direct_mem_ptr(tlm_target_socket& origin,
                              tlm_generic_payload& tx, tlm_dmi& dmi) {
-    const mapping& m = lookup(origin, tx);
+    const mapping& m = decode(in.index_of(origin), tx);
     if (m.target == TARGET_NONE)
         return false;
 
@@ -234,6 +448,11 @@ bus::bus(const sc_module_name& nm):
     component(nm),
     m_mappings(),
     m_default(),
+    m_decoder(),
+    m_source_decoders(),
+    m_elaborated(false),
+    m_stale(false),
+    m_route_caches(),
     lenient("lenient", false),
     in("in"),
     out("out") {
@@ -242,6 +461,8 @@ bus::bus(const sc_module_name& nm):
     m_default.addr = range(0ull, ~0ull);
     m_default.offset = 0;
     register_command("mmap", 0, &bus::cmd_mmap, "shows the bus memory map");
+    register_command("routes", 0, &bus::cmd_routes,
+                     "shows route cache statistics for each bus initiator");
 }
 
 bus::~bus() {
@@ -13,7 +13,43 @@
 namespace vcml {
 namespace generic {
 
+void memory::show_placement(ostream& os) {
+    if (m_sparse) {
+        os << "size: " << size << " bytes (sparse)" << std::endl;
+        os << "resident: " << m_sparse->resident_pages() << " pages ("
+           << m_sparse->resident_bytes() << " bytes)" << std::endl;
+        os << "page tables: " << m_sparse->resident_tables() << " ("
+           << m_sparse->levels() << " levels)";
+        return;
+    }
+
+    auto status = [](bool requested, bool granted) -> const char* {
+        if (!requested)
+            return "off";
+        return granted ? "on" : "refused by host";
+    };
+
+    os << "size: " << size << " bytes" << std::endl;
+    os << "hugetlb: " << status(hugetlb, m_memory.has_hugetlb()) << std::endl;
+    os << "hugepages: " << status(hugepages, m_memory.has_hugepages())
+       << std::endl;
+    os << "prefault: " << status(prefault, m_memory.is_prefaulted())
+       << std::endl;
+    os << "numa node: ";
+    if (numa_node < 0)
+        os << "any";
+    else if (m_memory.numa_node() < 0)
+        os << numa_node << " (refused by host)";
+    else
+        os << m_memory.numa_node();
+}
+
 bool memory::cmd_show(const vector<string>& args, ostream& os) {
+    if (args.size() < 2) {
+        show_placement(os);
+        return true;
+    }
+
     u64 start = strtoull(args[0].c_str(), NULL, 0);
     u64 end = strtoull(args[1].c_str(), NULL, 0);
 
@@ -30,7 +66,11 @@ bool memory::cmd_show(const vector<string>& args, ostream& os) {
             os << "\n" << HEX(addr, 8) << ":";
         if ((addr % 4) == 0)
             os << " ";
-        if (addr >= start)
+        if (addr >= start && m_sparse) {
+            u8 val = 0;
+            m_sparse->read({ addr, addr }, &val, true);
+            os << HEX((unsigned int)val, 2) << " ";
+        } else if (addr >= start)
             os << HEX((unsigned int)m_memory[addr], 2) << " ";
         else
             os << "   ";
@@ -41,6 +81,67 @@ bool memory::cmd_show(const vector<string>& args, ostream& os) {
     return true;
 }
 
+bool memory::cmd_snapshot(const vector<string>& args, ostream& os) {
+    if (m_sparse) {
+        os << "snapshots not supported for sparse memory";
+        return false;
+    }
+
+    if (args.empty()) {
+        os << "snapshots:";
+        for (const string& name : m_memory.snapshots())
+            os << " " << name;
+        return true;
+    }
+
+    if (!m_memory.snapshot(args[0])) {
+        os << "cannot snapshot shared or hugetlb memory";
+        return false;
+    }
+
+    os << "created snapshot " << args[0];
+    return true;
+}
+
+bool memory::cmd_restore(const vector<string>& args, ostream& os) {
+    if (m_sparse) {
+        os << "snapshots not supported for sparse memory";
+        return false;
+    }
+
+    if (!m_memory.restore(args[0])) {
+        os << "no such snapshot: " << args[0];
+        return false;
+    }
+
+    os << "restored snapshot " << args[0];
+    return true;
+}
+
+void memory::update_dmi() {
+    unmap_dmi(0, size - 1);
+
+    // while tracking dirty pages, writes must go through m_memory
+    tlm_dmi dmi(m_memory);
+    if (m_memory.is_tracking_dirty()) {
+        if (!dmi.is_read_allowed())
+            return;
+        dmi.allow_read();
+    }
+
+    map_dmi(dmi);
+}
+
+void memory::load_bin(const string& filename, u64 offset) {
+    if (map_images && !m_sparse && m_memory.map_file(filename, offset)) {
+        log_debug("mapped binary file '%s' to offset 0x%llx",
+                  filename.c_str(), offset);
+        return;
+    }
+
+    loader::load_bin(filename, offset);
+}
+
 u8* memory::allocate_image(u64 sz, u64 off) {
     if (off >= size)
         VCML_REPORT("offset 0x%llx exceeds memory size", off);
@@ -48,6 +149,10 @@ u8* memory::allocate_image(u64 sz, u64 off) {
     if (sz + off > size)
         VCML_REPORT("image too big for memory");
 
+    if (m_sparse)
+        return nullptr; // use copy_image instead
+
+    m_memory.mark_dirty({ off, off + sz - 1 });
     return m_memory.data() + off;
 }
 
@@ -58,7 +163,13 @@ void memory::copy_image(const u8* image, u64 sz, u64 off) {
     if (sz + off > size)
         VCML_REPORT("image too big for memory");
 
+    if (m_sparse) {
+        m_sparse->write({ off, off + sz - 1 }, image, true);
+        return;
+    }
+
     memcpy(m_memory.data() + off, image, sz);
+    m_memory.mark_dirty({ off, off + sz - 1 });
 }
 
 memory::memory(const sc_module_name& nm, u64 sz, bool read_only, alignment al,
@@ -66,50 +177,196 @@ memory::memory(const sc_module_name& nm, u64 sz, bool read_only, alignment al,
     peripheral(nm, host_endian(), rl, wl),
     debugging::loader(*this, true),
     m_memory(),
+    m_sparse(nullptr),
     size("size", sz),
     align("align", al),
     discard_writes("discard_writes", false),
     readonly("readonly", read_only),
     shared("shared", ""),
     images("images"),
+    map_images("map_images", false),
     poison("poison", 0x00),
+    hugetlb("hugetlb", false),
+    hugepages("hugepages", false),
+    prefault("prefault", false),
+    numa_node("numa_node", -1),
+    sparse("sparse", false),
     in("in") {
     VCML_ERROR_ON(size == 0u, "memory size cannot be 0");
     VCML_ERROR_ON(al > VCML_ALIGN_1G, "requested alignment too big");
 
-    m_memory.init(shared, size, align);
-    m_memory.set_read_latency(read_cycles());
-    m_memory.set_write_latency(write_cycles());
+    if (sparse) {
+        VCML_ERROR_ON(!shared.get().empty(), "sparse memory cannot be shared");
+        if (hugetlb || hugepages || prefault || numa_node >= 0)
+            log_warn("placement options are ignored for sparse memory");
+        if (poison > 0)
+            log_warn("poison is ignored for sparse memory");
 
-    if (readonly)
-        m_memory.allow_read_only();
-    if (discard_writes)
-        m_memory.discard_writes();
+        m_sparse = new tlm_sparse_memory(size);
+        m_sparse->allow_read_only(readonly);
+        m_sparse->discard_writes(discard_writes);
+    } else {
+        m_memory.init(shared, size, align, hugetlb);
+        if (hugetlb && !m_memory.has_hugetlb())
+            log_warn("host refused hugetlb pages, using regular pages");
+        if (hugepages && !m_memory.use_hugepages())
+            log_warn("host refused transparent huge pages");
+        if (numa_node >= 0 && !m_memory.bind_numa(numa_node))
+            log_warn("host refused binding memory to numa node %d",
+                     (int)numa_node);
+        if (prefault && !m_memory.prefault())
+            log_warn("failed to prefault memory");
 
-    map_dmi(m_memory);
+        m_memory.set_read_latency(read_cycles());
+        m_memory.set_write_latency(write_cycles());
 
-    register_command("show", 2, &memory::cmd_show,
-                     "show [start] [end] to print memory contents");
+        if (readonly)
+            m_memory.allow_read_only();
+        if (discard_writes)
+            m_memory.discard_writes();
+
+        map_dmi(m_memory);
+    }
+
+    register_command("show", 0, &memory::cmd_show,
+                     "show [start] [end] to print memory contents, reports "
+                     "memory placement if no range is given");
+    register_command("snapshot", 0, &memory::cmd_snapshot,
+                     "snapshot [name] to save the current memory contents, "
+                     "lists all snapshots if no name is given");
+    register_command("restore", 1, &memory::cmd_restore,
+                     "restore <name> to load memory contents from a snapshot");
 }
 
 memory::~memory() {
-    // nothing to do
+    delete m_sparse;
 }
 
 void memory::reset() {
-    if (poison > 0)
+    if (poison > 0 && !m_sparse)
         m_memory.fill(poison);
 
     load_images(images);
 }
 
+void memory::serialize(checkpoint& cp) {
+    peripheral::serialize(cp);
+
+    bool is_sparse = m_sparse != nullptr;
+    u64 len = size;
+    cp.value(is_sparse);
+    cp.value(len);
+
+    VCML_ERROR_ON(is_sparse != (m_sparse != nullptr),
+                  "checkpoint memory type mismatch");
+    VCML_ERROR_ON(len != size, "checkpoint memory size mismatch");
+
+    if (m_sparse) {
+        serialize_sparse(cp);
+        return;
+    }
+
+    if (cp.is_saving()) {
+        cp.data(m_memory.data(), len);
+        return;
+    }
+
+    // only write back pages that differ, so that unchanged copy-on-write
+    // pages stay shared and dirty tracking sees exactly what was restored
+    const u64 pgsz = 1ull << tlm_memory::DIRTY_PAGE_BITS;
+    vector<u8> page(pgsz);
+    for (u64 addr = 0; addr < len; addr += pgsz) {
+        u64 n = min(pgsz, len - addr);
+        cp.data(page.data(), n);
+        if (memcmp(m_memory.data() + addr, page.data(), n) != 0) {
+            memcpy(m_memory.data() + addr, page.data(), n);
+            m_memory.mark_dirty({ addr, addr + n - 1 });
+        }
+    }
+}
+
+// sparse memory stores the addresses of its resident pages followed by
+// their contents; pages are only populated or cleared when restoring, so
+// DMI pointers handed out before stay valid
+void memory::serialize_sparse(checkpoint& cp) {
+    const u64 pgsz = tlm_sparse_memory::PAGE_SIZE;
+    vector<u64> resident = m_sparse->resident();
+    vector<u64> pages(resident);
+    cp.value(pages);
+
+    for (size_t i = 0; i < pages.size(); i++) {
+        u64 addr = pages[i];
+        bool sorted = i == 0 || addr > pages[i - 1];
+        VCML_ERROR_ON(addr % pgsz || addr >= size || !sorted,
+                      "invalid sparse page 0x%llx in checkpoint", addr);
+
+        u8* ptr = cp.is_saving() ? m_sparse->lookup(addr)
+                                 : m_sparse->populate(addr);
+        cp.data(ptr, min(pgsz, size.get() - addr));
+    }
+
+    if (cp.is_saving())
+        return;
+
+    // pages that became resident after the checkpoint read zero again
+    for (u64 addr : resident) {
+        if (!std::binary_search(pages.begin(), pages.end(), addr))
+            memset(m_sparse->lookup(addr), 0, min(pgsz, size.get() - addr));
+    }
+}
+
+void memory::track_dirty(bool enable) {
+    VCML_ERROR_ON(m_sparse, "dirty tracking not supported for sparse memory");
+    if (enable == m_memory.is_tracking_dirty())
+        return;
+
+    m_memory.track_dirty(enable);
+    update_dmi();
+}
+
+vector<range> memory::fetch_dirty(bool clear) {
+    return m_memory.fetch_dirty(clear);
+}
+
+bool memory::is_memory_like(const range& addr, address_space as) const {
+    return true;
+}
+
+bool memory::get_direct_mem_ptr(tlm_target_socket& origin,
+                                tlm_generic_payload& tx, tlm_dmi& dmi) {
+    // sparse pages are handed out on demand, once they are resident
+    if (!m_sparse || !m_sparse->get_dmi(tx.get_address(), dmi))
+        return false;
+
+    dmi.set_read_latency(read_cycles());
+    dmi.set_write_latency(write_cycles());
+    return true;
+}
+
+unsigned int memory::transport(tlm_generic_payload& tx, const tlm_sbi& info,
+                               address_space as) {
+    unsigned int n = peripheral::transport(tx, info, as);
+
+    // let initiators ask for DMI to pages that are resident by now
+    if (m_sparse && tx.is_response_ok() && !info.is_excl &&
+        m_sparse->lookup(tx.get_address()) != nullptr)
+        tx.set_dmi_allowed(true);
+
+    return n;
+}
+
 tlm_response_status memory::read(const range& addr, void* data,
                                  const tlm_sbi& info) {
+    if (m_sparse)
+        return m_sparse->read(addr, data, info.is_debug);
     return m_memory.read(addr, data, info.is_debug);
 }
 
 tlm_response_status memory::write(const range& addr, const void* data,
                                   const tlm_sbi& info) {
+    if (m_sparse)
+        return m_sparse->write(addr, data, info.is_debug);
+
     return m_memory.write(addr, data, info.is_debug);
 }
 
@@ -213,18 +213,22 @@ void ocfbc::render() {
 
         u8* fb = m_fb;
 
+        vector<tlm_iovec> bursts;
+        bursts.reserve(linesz / burstsz + 1);
+
         for (u32 y = 0; y < m_yres; y++) {
             // burst-read one horizontal line of pixels into buffer
-            for (u32 x = 0; x < linesz; x += burstsz) {
-                u32 base = (stat & STAT_AVMP) ? vbarb : vbara;
-                u32 addr = base + y * linesz + x;
-                u8* dest = m_pc ? linebuf : fb;
-                if (failed(rs = out.read(addr, dest + x, burstsz))) {
-                    log_debug("failed to read vmem at 0x%08x: %s", addr,
-                              tlm_response_to_str(rs));
-                    stat |= STAT_SINT;
-                    irq = true;
-                }
+            bursts.clear();
+            u32 base = (stat & STAT_AVMP) ? vbarb : vbara;
+            u8* dest = m_pc ? linebuf : fb;
+            for (u32 x = 0; x < linesz; x += burstsz)
+                bursts.push_back({ base + y * linesz + x, dest + x, burstsz });
+
+            if (failed(rs = out.readv(bursts))) {
+                log_debug("failed to read vmem at 0x%08x: %s",
+                          base + y * linesz, tlm_response_to_str(rs));
+                stat |= STAT_SINT;
+                irq = true;
             }
 
             if (!m_pc) {
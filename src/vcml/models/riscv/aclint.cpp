@@ -15,7 +15,7 @@ namespace riscv {
 
 u64 aclint::get_cycles() const {
     sc_time delta = sc_time_stamp() - m_time_reset;
-    return delta / clock_cycle();
+    return m_cycles_reset + delta / clock_cycle();
 }
 
 u64 aclint::read_mtime() {
@@ -87,6 +87,7 @@ void aclint::update_timer() {
 aclint::aclint(const sc_module_name& nm):
     peripheral(nm),
     m_time_reset(),
+    m_cycles_reset(0),
     m_trigger("triggerev"),
     comp_base("comp_base", 0x0000),
     time_base("time_base", 0x7ff8),
@@ -102,21 +103,21 @@ aclint::aclint(const sc_module_name& nm):
     sswi("sswi", ACLINT_AS_SSWI) {
     mtimecmp.sync_on_write();
     mtimecmp.allow_read_write();
-    mtimecmp.on_write(&aclint::write_mtimecmp);
+    mtimecmp.on_write<&aclint::write_mtimecmp>();
 
     mtime.sync_on_read();
     mtime.allow_read_only();
-    mtime.on_read(&aclint::read_mtime);
+    mtime.on_read<&aclint::read_mtime>();
 
     msip.sync_always();
     msip.allow_read_write();
-    msip.on_read(&aclint::read_msip);
-    msip.on_write(&aclint::write_msip);
+    msip.on_read<&aclint::read_msip>();
+    msip.on_write<&aclint::write_msip>();
 
     ssip.sync_always();
     ssip.allow_read_write();
-    ssip.on_read(&aclint::read_ssip);
-    ssip.on_write(&aclint::write_ssip);
+    ssip.on_read<&aclint::read_ssip>();
+    ssip.on_write<&aclint::write_ssip>();
 
     SC_HAS_PROCESS(aclint);
     SC_METHOD(update_timer);
@@ -132,6 +133,27 @@ void aclint::reset() {
     peripheral::reset();
 
     m_time_reset = sc_time_stamp();
+    m_cycles_reset = 0;
+}
+
+void aclint::serialize(checkpoint& cp) {
+    peripheral::serialize(cp);
+
+    u64 mtime = get_cycles();
+    cp.value(mtime);
+
+    if (cp.is_restoring()) {
+        // mtime continues from the checkpoint, pending compares are re-armed
+        m_time_reset = sc_time_stamp();
+        m_cycles_reset = mtime;
+        m_trigger.cancel();
+        update_timer();
+
+        for (auto& [hart, port] : irq_mswi)
+            port->write(msip.get(hart) != 0);
+        for (auto& [hart, port] : irq_sswi)
+            port->write(ssip.get(hart) != 0);
+    }
 }
 
 VCML_EXPORT_MODEL(vcml::riscv::aclint, name, args) {
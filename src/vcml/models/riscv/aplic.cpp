@@ -505,27 +505,27 @@ aplic::hartidc::hartidc(size_t hart):
     idelivery.tag = hart;
     idelivery.sync_always();
     idelivery.allow_read_write();
-    idelivery.on_write(&aplic::write_idelivery);
+    idelivery.on_write<&aplic::write_idelivery>();
 
     iforce.tag = hart;
     iforce.sync_always();
     iforce.allow_read_write();
-    iforce.on_write(&aplic::write_iforce);
+    iforce.on_write<&aplic::write_iforce>();
 
     ithreshold.tag = hart;
     ithreshold.sync_always();
     ithreshold.allow_read_write();
-    ithreshold.on_write(&aplic::write_ithreshold);
+    ithreshold.on_write<&aplic::write_ithreshold>();
 
     topi.tag = hart;
     topi.sync_always();
     topi.allow_read_write();
-    topi.on_read(&aplic::read_topi);
+    topi.on_read<&aplic::read_topi>();
 
     claimi.tag = hart;
     claimi.sync_always();
     claimi.allow_read_write();
-    claimi.on_read(&aplic::read_claimi);
+    claimi.on_read<&aplic::read_claimi>();
 }
 
 aplic::hartidc::~hartidc() {
@@ -564,29 +564,29 @@ aplic::aplic(const sc_module_name& nm, aplic* parent):
     domaincfg.sync_always();
     domaincfg.allow_read_write();
     domaincfg.natural_accesses_only();
-    domaincfg.on_write(&aplic::write_domaincfg);
+    domaincfg.on_write<&aplic::write_domaincfg>();
 
     sourcecfg.sync_always();
     sourcecfg.allow_read_write();
     sourcecfg.natural_accesses_only();
-    sourcecfg.on_read(&aplic::read_sourcecfg);
-    sourcecfg.on_write(&aplic::write_sourcecfg);
+    sourcecfg.on_read<&aplic::read_sourcecfg>();
+    sourcecfg.on_write<&aplic::write_sourcecfg>();
 
     mmsiaddrcfg.sync_always();
     mmsiaddrcfg.natural_accesses_only();
-    mmsiaddrcfg.on_write(&aplic::write_mmsiaddrcfg);
+    mmsiaddrcfg.on_write<&aplic::write_mmsiaddrcfg>();
 
     mmsiaddrcfgh.sync_always();
     mmsiaddrcfgh.natural_accesses_only();
-    mmsiaddrcfgh.on_write(&aplic::write_mmsiaddrcfgh);
+    mmsiaddrcfgh.on_write<&aplic::write_mmsiaddrcfgh>();
 
     smsiaddrcfg.sync_always();
     smsiaddrcfg.natural_accesses_only();
-    smsiaddrcfg.on_write(&aplic::write_smsiaddrcfg);
+    smsiaddrcfg.on_write<&aplic::write_smsiaddrcfg>();
 
     smsiaddrcfgh.sync_always();
     smsiaddrcfgh.natural_accesses_only();
-    smsiaddrcfgh.on_write(&aplic::write_smsiaddrcfgh);
+    smsiaddrcfgh.on_write<&aplic::write_smsiaddrcfgh>();
 
     if (mmode) {
         mmsiaddrcfg.allow_read_write();
@@ -603,74 +603,74 @@ aplic::aplic(const sc_module_name& nm, aplic* parent):
     setip.sync_always();
     setip.allow_read_write();
     setip.natural_accesses_only();
-    setip.on_read(&aplic::read_setip);
-    setip.on_write(&aplic::write_setip);
+    setip.on_read<&aplic::read_setip>();
+    setip.on_write<&aplic::write_setip>();
 
     setipnum.sync_always();
     setipnum.allow_read_write();
     setipnum.natural_accesses_only();
-    setipnum.on_read(&aplic::read_zero);
-    setipnum.on_write(&aplic::write_setipnum);
+    setipnum.on_read<&aplic::read_zero>();
+    setipnum.on_write<&aplic::write_setipnum>();
 
     in_clrip.sync_always();
     in_clrip.allow_read_write();
     in_clrip.natural_accesses_only();
-    in_clrip.on_read(&aplic::read_in);
-    in_clrip.on_write(&aplic::write_clrip);
+    in_clrip.on_read<&aplic::read_in>();
+    in_clrip.on_write<&aplic::write_clrip>();
 
     clripnum.sync_always();
     clripnum.allow_read_write();
     clripnum.natural_accesses_only();
-    clripnum.on_read(&aplic::read_zero);
-    clripnum.on_write(&aplic::write_clripnum);
+    clripnum.on_read<&aplic::read_zero>();
+    clripnum.on_write<&aplic::write_clripnum>();
 
     setie.sync_always();
     setie.allow_read_write();
     setie.natural_accesses_only();
-    setie.on_read(&aplic::read_setie);
-    setie.on_write(&aplic::write_setie);
+    setie.on_read<&aplic::read_setie>();
+    setie.on_write<&aplic::write_setie>();
 
     setienum.sync_always();
     setienum.allow_read_write();
     setienum.natural_accesses_only();
-    setienum.on_read(&aplic::read_zero);
-    setienum.on_write(&aplic::write_setienum);
+    setienum.on_read<&aplic::read_zero>();
+    setienum.on_write<&aplic::write_setienum>();
 
     clrie.sync_always();
     clrie.allow_read_write();
     clrie.natural_accesses_only();
-    clrie.on_read(&aplic::read_zero_idx);
-    clrie.on_write(&aplic::write_clrie);
+    clrie.on_read<&aplic::read_zero_idx>();
+    clrie.on_write<&aplic::write_clrie>();
 
     clrienum.sync_always();
     clrienum.allow_read_write();
     clrienum.natural_accesses_only();
-    clrienum.on_read(&aplic::read_zero);
-    clrienum.on_write(&aplic::write_clrienum);
+    clrienum.on_read<&aplic::read_zero>();
+    clrienum.on_write<&aplic::write_clrienum>();
 
     setipnum_le.sync_always();
     setipnum_le.allow_read_write();
     setipnum_le.natural_accesses_only();
-    setipnum_le.on_read(&aplic::read_zero);
-    setipnum_le.on_write(&aplic::write_setipnum_le);
+    setipnum_le.on_read<&aplic::read_zero>();
+    setipnum_le.on_write<&aplic::write_setipnum_le>();
 
     setipnum_be.sync_always();
     setipnum_be.allow_read_write();
     setipnum_be.natural_accesses_only();
-    setipnum_be.on_read(&aplic::read_zero);
-    setipnum_be.on_write(&aplic::write_setipnum_be);
+    setipnum_be.on_read<&aplic::read_zero>();
+    setipnum_be.on_write<&aplic::write_setipnum_be>();
 
     genmsi.sync_always();
     genmsi.allow_read_write();
     genmsi.natural_accesses_only();
-    genmsi.on_read(&aplic::read_genmsi);
-    genmsi.on_write(&aplic::write_genmsi);
+    genmsi.on_read<&aplic::read_genmsi>();
+    genmsi.on_write<&aplic::write_genmsi>();
 
     targetcfg.sync_always();
     targetcfg.allow_read_write();
     targetcfg.natural_accesses_only();
-    targetcfg.on_read(&aplic::read_targetcfg);
-    targetcfg.on_write(&aplic::write_targetcfg);
+    targetcfg.on_read<&aplic::read_targetcfg>();
+    targetcfg.on_write<&aplic::write_targetcfg>();
 
     if (m_parent)
         m_parent->m_children.push_back(this);
@@ -79,16 +79,16 @@ clint::clint(const sc_module_name& nm):
     in("in") {
     msip.sync_always();
     msip.allow_read_write();
-    msip.on_read(&clint::read_msip);
-    msip.on_write(&clint::write_msip);
+    msip.on_read<&clint::read_msip>();
+    msip.on_write<&clint::write_msip>();
 
     mtimecmp.sync_on_write();
     mtimecmp.allow_read_write();
-    mtimecmp.on_write(&clint::write_mtimecmp);
+    mtimecmp.on_write<&clint::write_mtimecmp>();
 
     mtime.sync_on_read();
     mtime.allow_read_only();
-    mtime.on_read(&clint::read_mtime);
+    mtime.on_read<&clint::read_mtime>();
 
     SC_HAS_PROCESS(clint);
     SC_METHOD(update_timer);
@@ -18,12 +18,12 @@ plic::context::context(size_t no):
     threshold(mkstr("ctx%zu_threshold", no), BASE + no * SIZE + 0),
     claim(mkstr("ctx%zu_claim", no), BASE + no * SIZE + 4) {
     threshold.allow_read_write();
-    threshold.on_write(&plic::write_threshold);
+    threshold.on_write<&plic::write_threshold>();
     threshold.tag = no;
 
     claim.allow_read_write();
-    claim.on_read(&plic::read_claim);
-    claim.on_write(&plic::write_complete);
+    claim.on_read<&plic::read_claim>();
+    claim.on_write<&plic::write_complete>();
     claim.tag = no;
 
     for (size_t regno = 0; regno < NIRQ / 32; regno++) {
@@ -32,7 +32,7 @@ plic::context::context(size_t no):
 
         enabled[regno] = new reg<u32>(rnm, 0x2000 + gid * 4);
         enabled[regno]->allow_read_write();
-        enabled[regno]->on_write(&plic::write_enabled);
+        enabled[regno]->on_write<&plic::write_enabled>();
         enabled[regno]->tag = gid;
     }
 }
@@ -185,10 +185,10 @@ plic::plic(const sc_module_name& nm):
     irqt("irqt", NCTX),
     in("in") {
     priority.allow_read_write();
-    priority.on_write(&plic::write_priority);
+    priority.on_write<&plic::write_priority>();
 
     pending.allow_read_only();
-    pending.on_read(&plic::read_pending);
+    pending.on_read<&plic::read_pending>();
 
     for (unsigned int ctx = 0; ctx < NCTX; ctx++)
         m_contexts[ctx] = nullptr;
@@ -185,49 +185,49 @@ nrf51::nrf51(const sc_module_name& nm):
     irq("irq") {
     start.sync_always();
     start.allow_read_write();
-    start.on_write(&nrf51::write_start);
+    start.on_write<&nrf51::write_start>();
 
     stop.sync_always();
     stop.allow_read_write();
-    stop.on_write(&nrf51::write_stop);
+    stop.on_write<&nrf51::write_stop>();
 
     count.sync_always();
     count.allow_read_write();
-    count.on_write(&nrf51::write_count);
+    count.on_write<&nrf51::write_count>();
 
     clear.sync_always();
     clear.allow_read_write();
-    clear.on_write(&nrf51::write_clear);
+    clear.on_write<&nrf51::write_clear>();
 
     shutdown.sync_always();
     shutdown.allow_read_write();
-    shutdown.on_write(&nrf51::write_shutdown);
+    shutdown.on_write<&nrf51::write_shutdown>();
 
     capture.sync_always();
     capture.allow_read_write();
-    capture.on_write(&nrf51::write_capture);
+    capture.on_write<&nrf51::write_capture>();
 
     compare.sync_always();
     compare.allow_read_write();
-    compare.on_write(&nrf51::write_compare);
+    compare.on_write<&nrf51::write_compare>();
 
     shorts.sync_always();
     shorts.allow_read_write();
-    shorts.on_write(&nrf51::write_shorts);
+    shorts.on_write<&nrf51::write_shorts>();
 
     intenset.sync_always();
     intenset.allow_read_write();
     intenset.on_read([&]() -> u32 { return m_inten; });
-    intenset.on_write(&nrf51::write_intenset);
+    intenset.on_write<&nrf51::write_intenset>();
 
     intenclr.sync_always();
     intenclr.allow_read_write();
     intenclr.on_read([&]() -> u32 { return m_inten; });
-    intenclr.on_write(&nrf51::write_intenclr);
+    intenclr.on_write<&nrf51::write_intenclr>();
 
     cc.sync_always();
     cc.allow_read_write();
-    cc.on_write(&nrf51::write_cc);
+    cc.on_write<&nrf51::write_cc>();
 
     SC_HAS_PROCESS(nrf51);
     SC_METHOD(update);
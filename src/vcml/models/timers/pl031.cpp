@@ -82,23 +82,23 @@ pl031::pl031(const sc_module_name& nm):
     irq("irq") {
     dr.sync_always();
     dr.allow_read_only();
-    dr.on_read(&pl031::read_dr);
+    dr.on_read<&pl031::read_dr>();
 
     mr.sync_always();
     mr.allow_read_write();
-    mr.on_write(&pl031::write_mr);
+    mr.on_write<&pl031::write_mr>();
 
     lr.sync_always();
     lr.allow_read_write();
-    lr.on_write(&pl031::write_lr);
+    lr.on_write<&pl031::write_lr>();
 
     cr.sync_always();
     cr.allow_read_write();
-    cr.on_write(&pl031::write_cr);
+    cr.on_write<&pl031::write_cr>();
 
     imsc.sync_always();
     imsc.allow_read_write();
-    imsc.on_write(&pl031::write_imsc);
+    imsc.on_write<&pl031::write_imsc>();
 
     ris.sync_always();
     ris.allow_read_only();
@@ -109,7 +109,7 @@ pl031::pl031(const sc_module_name& nm):
 
     icr.sync_always();
     icr.allow_write_only();
-    icr.on_write(&pl031::write_icr);
+    icr.on_write<&pl031::write_icr>();
 
     SC_HAS_PROCESS(pl031);
     SC_METHOD(update);
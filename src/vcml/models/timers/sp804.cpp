@@ -39,8 +39,8 @@ void sp804::timer::schedule(u32 ticks) {
     hz_t effclk = clk / get_prescale_divider();
     sc_time delta((double)ticks / (double)effclk, SC_SEC);
 
-    m_prev = sc_time_stamp();
-    m_next = m_prev + delta;
+    m_period = delta;
+    m_next = sc_time_stamp() + delta;
     m_ev.notify(delta);
 }
 
@@ -48,8 +48,11 @@ u32 sp804::timer::read_value() {
     if (!is_enabled())
         return load;
 
-    double delta = (sc_time_stamp() - m_prev) / (m_next - m_prev);
-    return load * (1.0 - delta);
+    sc_time now = sc_time_stamp();
+    if (m_period == SC_ZERO_TIME || now >= m_next)
+        return 0;
+
+    return load * ((m_next - now) / m_period);
 }
 
 u32 sp804::timer::read_ris() {
@@ -86,7 +89,7 @@ void sp804::timer::write_bgload(u32 val) {
 sp804::timer::timer(const sc_module_name& nm):
     peripheral(nm),
     m_ev("event"),
-    m_prev(SC_ZERO_TIME),
+    m_period(SC_ZERO_TIME),
     m_next(SC_ZERO_TIME),
     m_timer(dynamic_cast<sp804*>(get_parent_object())),
     load("load", 0x00, 0x00000000),
@@ -99,31 +102,31 @@ sp804::timer::timer(const sc_module_name& nm):
     irq("irq") {
     load.sync_always();
     load.allow_read_write();
-    load.on_write(&timer::write_load);
+    load.on_write<&timer::write_load>();
 
     value.sync_always();
     value.allow_read_only();
-    value.on_read(&timer::read_value);
+    value.on_read<&timer::read_value>();
 
     control.sync_always();
     control.allow_read_write();
-    control.on_write(&timer::write_control);
+    control.on_write<&timer::write_control>();
 
     intclr.sync_always();
     intclr.allow_write_only();
-    intclr.on_write(&timer::write_intclr);
+    intclr.on_write<&timer::write_intclr>();
 
     ris.sync_always();
     ris.allow_read_only();
-    ris.on_read(&timer::read_ris);
+    ris.on_read<&timer::read_ris>();
 
     mis.sync_always();
     mis.allow_read_only();
-    mis.on_read(&timer::read_mis);
+    mis.on_read<&timer::read_mis>();
 
     bgload.sync_always();
     bgload.allow_read_write();
-    bgload.on_write(&timer::write_bgload);
+    bgload.on_write<&timer::write_bgload>();
 
     SC_HAS_PROCESS(timer);
     SC_METHOD(trigger);
@@ -140,6 +143,33 @@ void sp804::timer::reset() {
     m_ev.cancel();
 }
 
+void sp804::timer::serialize(checkpoint& cp) {
+    peripheral::serialize(cp);
+
+    // timeouts are stored relative to the time the checkpoint was taken
+    sc_time now = sc_time_stamp();
+    bool pending = is_enabled() && m_next > now;
+    u64 period = m_period.value();
+    u64 remaining = pending ? (m_next - now).value() : 0;
+    bool line = irq.read();
+
+    cp.value(pending);
+    cp.value(period);
+    cp.value(remaining);
+    cp.value(line);
+
+    if (cp.is_restoring()) {
+        m_ev.cancel();
+        m_period = time_from_value(period);
+        m_next = now + time_from_value(remaining);
+        if (pending)
+            m_ev.notify(m_next - now);
+
+        irq = line;
+        m_timer->update_irqc();
+    }
+}
+
 void sp804::update_irqc() {
     irqc = timer1.irq || timer2.irq;
 }
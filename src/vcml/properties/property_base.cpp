@@ -29,7 +29,8 @@ property_base::property_base(const char* nm):
 property_base::property_base(sc_object* parent, const char* nm):
     sc_attr_base(nm),
     m_parent(parent),
-    m_fullname(gen_hierarchy_name(nm, parent)) {
+    m_fullname(gen_hierarchy_name(nm, parent)),
+    m_checkpointed(false) {
     VCML_ERROR_ON(!m_parent, "property '%s' has no parent object", nm);
     if (!m_parent->add_attribute(*this))
         VCML_ERROR("property %s already defined", fullname());
@@ -39,4 +40,11 @@ property_base::~property_base() {
     m_parent->remove_attribute(name());
 }
 
+void property_base::serialize(checkpoint& cp) {
+    string val = cp.is_saving() ? str() : "";
+    cp.value(val);
+    if (cp.is_restoring())
+        str(val);
+}
+
 } // namespace vcml
@@ -44,39 +44,147 @@ static tlm_dmi dmi_merge(const tlm_dmi& a, const tlm_dmi& b) {
     return result;
 }
 
-tlm_dmi_cache::tlm_dmi_cache(): m_limit(16), m_entries() {
-    // nothing to do
+struct dmi_slot {
+    const tlm_dmi_cache* owner;
+    u64 generation;
+    tlm_dmi dmi;
+};
+
+// every thread remembers its last hit for a handful of caches, these slots
+// are validated against the cache generation and need no locking at all
+static thread_local dmi_slot g_slots[4];
+
+static dmi_slot& dmi_get_slot(const tlm_dmi_cache* cache) {
+    uintptr_t hash = reinterpret_cast<uintptr_t>(cache) >> 4;
+    return g_slots[(hash ^ (hash >> 2)) & (std::size(g_slots) - 1)];
+}
+
+static u64 dmi_next_generation() {
+    static atomic<u64> generation(0);
+    return ++generation;
+}
+
+void tlm_dmi_cache::table::insert(const tlm_dmi& dmi, u64 stamp) {
+    auto it = std::upper_bound(entries.begin(), entries.end(),
+                               dmi.get_start_address(),
+                               [](u64 addr, const tlm_dmi& entry) -> bool {
+                                   return addr < entry.get_start_address();
+                               });
+
+    size_t idx = it - entries.begin();
+    entries.insert(it, dmi);
+    stamps.insert(stamps.begin() + idx, stamp);
+}
+
+void tlm_dmi_cache::table::remove(size_t idx) {
+    entries.erase(entries.begin() + idx);
+    stamps.erase(stamps.begin() + idx);
+}
+
+void tlm_dmi_cache::table::update() {
+    limits.resize(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        limits[i] = entries[i].get_end_address();
+        if (i > 0 && limits[i - 1] > limits[i])
+            limits[i] = limits[i - 1];
+    }
+}
+
+const tlm_dmi* tlm_dmi_cache::table::find(const range& r,
+                                          vcml_access rwx) const {
+    auto it = std::upper_bound(entries.begin(), entries.end(), r.start,
+                               [](u64 addr, const tlm_dmi& entry) -> bool {
+                                   return addr < entry.get_start_address();
+                               });
+
+    // walk backwards through all entries starting before r.start, we can stop
+    // as soon as no earlier entry reaches far enough to contain r.end
+    for (size_t i = it - entries.begin(); i-- > 0;) {
+        if (limits[i] < r.end)
+            break;
+        if (r.inside(entries[i]) && dmi_check_access(entries[i], rwx))
+            return &entries[i];
+    }
+
+    return nullptr;
+}
+
+tlm_dmi_cache::tlm_dmi_cache():
+    m_mtx(),
+    m_limit(16),
+    m_stamp(0),
+    m_table(new table()),
+    m_generation(dmi_next_generation()),
+    m_epoch(0) {
+    m_readers[0] = 0;
+    m_readers[1] = 0;
 }
 
 tlm_dmi_cache::~tlm_dmi_cache() {
-    // nothing to do
+    delete m_table.load();
+}
+
+vector<tlm_dmi> tlm_dmi_cache::get_entries() const {
+    size_t epoch = read_lock();
+    vector<tlm_dmi> entries(m_table.load()->entries);
+    read_unlock(epoch);
+    return entries;
+}
+
+void tlm_dmi_cache::publish(table* next) {
+    next->update();
+
+    table* prev = m_table.exchange(next);
+    m_generation.store(dmi_next_generation(), std::memory_order_release);
+
+    // wait for all readers that might still look at the previous table
+    size_t epoch = m_epoch.fetch_add(1);
+    while (m_readers[epoch & 1].load(std::memory_order_acquire) > 0)
+        mwr::cpu_yield();
+
+    delete prev;
 }
 
-void tlm_dmi_cache::insert_locked(const tlm_dmi& dmi) {
+void tlm_dmi_cache::insert_locked(table& t, const tlm_dmi& dmi) {
     tlm_dmi merged(dmi);
+    u64 stamp = ++m_stamp;
+
     while (true) {
-        vector<tlm_dmi>::iterator it = std::find_if(
-            m_entries.begin(), m_entries.end(),
-            [merged](const tlm_dmi& entry) -> bool {
-                return dmi_is_mergeable(merged, entry);
-            });
-
-        if (it == m_entries.end()) {
-            m_entries.insert(m_entries.begin(), merged);
+        auto it = std::find_if(t.entries.begin(), t.entries.end(),
+                               [merged](const tlm_dmi& entry) -> bool {
+                                   return dmi_is_mergeable(merged, entry);
+                               });
+
+        if (it == t.entries.end()) {
+            t.insert(merged, stamp);
             break;
         }
 
         merged = dmi_merge(merged, *it);
-        m_entries.erase(it, it + 1);
+        t.remove(it - t.entries.begin());
     };
 
-    if (m_entries.size() > m_limit)
-        m_entries.resize(m_limit);
+    while (t.entries.size() > m_limit) {
+        auto it = std::min_element(t.stamps.begin(), t.stamps.end());
+        t.remove(it - t.stamps.begin());
+    }
 }
 
 void tlm_dmi_cache::insert(const tlm_dmi& dmi) {
     lock_guard<mutex> guard(m_mtx);
-    insert_locked(dmi);
+
+    // repeated grants for known regions only refresh their eviction stamp,
+    // stamps are never read by lookups, so no new table is needed for that
+    table* curr = m_table.load();
+    const tlm_dmi* known = curr->find(range(dmi), VCML_ACCESS_NONE);
+    if (known && dmi_is_mergeable(*known, dmi)) {
+        curr->stamps[known - curr->entries.data()] = ++m_stamp;
+        return;
+    }
+
+    table* next = new table(*curr);
+    insert_locked(*next, dmi);
+    publish(next);
 }
 
 bool tlm_dmi_cache::invalidate(u64 start, u64 end) {
@@ -85,14 +193,17 @@ bool tlm_dmi_cache::invalidate(u64 start, u64 end) {
 
 bool tlm_dmi_cache::invalidate(const range& r) {
     lock_guard<mutex> guard(m_mtx);
-    vector<tlm_dmi> entries(m_entries.rbegin(), m_entries.rend());
-    m_entries.clear();
+    const table* curr = m_table.load();
+    table* next = new table();
 
     size_t invalidations = 0;
 
-    for (const tlm_dmi& dmi : entries) {
+    for (size_t i = 0; i < curr->entries.size(); i++) {
+        const tlm_dmi& dmi = curr->entries[i];
+        const u64 stamp = curr->stamps[i];
+
         if (!r.overlaps(dmi)) {
-            insert_locked(dmi);
+            next->insert(dmi, stamp);
             continue;
         }
 
@@ -102,31 +213,46 @@ bool tlm_dmi_cache::invalidate(const range& r) {
             tlm_dmi front(dmi);
             front.set_end_address(r.start - 1);
             if (front.get_start_address() < front.get_end_address())
-                insert_locked(front);
+                next->insert(front, stamp);
         }
 
         if (r.end != (u64)-1) {
             tlm_dmi back(dmi);
             dmi_set_start_address(back, r.end + 1);
             if (back.get_start_address() < back.get_end_address())
-                insert_locked(back);
+                next->insert(back, stamp);
         }
     }
 
-    return invalidations > 0;
+    if (invalidations == 0) {
+        delete next;
+        return false;
+    }
+
+    publish(next);
+    return true;
 }
 
 bool tlm_dmi_cache::lookup(const range& r, vcml_access rwx, tlm_dmi& out) {
-    lock_guard<mutex> guard(m_mtx);
-    for (unsigned int i = 0; i < m_entries.size(); i++) {
-        if (r.inside(m_entries[i]) && dmi_check_access(m_entries[i], rwx)) {
-            std::swap(m_entries[i], m_entries[0]);
-            out = m_entries[0];
-            return true;
-        }
+    u64 generation = m_generation.load(std::memory_order_acquire);
+    dmi_slot& slot = dmi_get_slot(this);
+    if (slot.owner == this && slot.generation == generation &&
+        r.inside(slot.dmi) && dmi_check_access(slot.dmi, rwx)) {
+        out = slot.dmi;
+        return true;
+    }
+
+    size_t epoch = read_lock();
+    const tlm_dmi* hit = m_table.load(std::memory_order_acquire)->find(r, rwx);
+    if (hit) {
+        out = *hit;
+        slot.owner = this;
+        slot.generation = generation;
+        slot.dmi = *hit;
     }
 
-    return false;
+    read_unlock(epoch);
+    return hit != nullptr;
 }
 
 } // namespace vcml
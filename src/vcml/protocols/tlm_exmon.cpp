@@ -12,59 +12,141 @@
 
 namespace vcml {
 
+tlm_exmon::tlm_exmon():
+    m_locks(), m_slots(), m_granules(), m_wide(), m_found() {
+    // nothing to do
+}
+
+void tlm_exmon::insert_lock(int cpu, const range& r) {
+    if ((size_t)cpu >= m_slots.size())
+        m_slots.resize(cpu + 1, 0);
+
+    m_locks.push_back({ cpu, r });
+    m_slots[cpu] = m_locks.size();
+
+    if (num_granules(r) > MAX_GRANULES) {
+        m_wide.push_back(cpu);
+        return;
+    }
+
+    for (u64 g = r.start >> GRANULE_BITS; g <= r.end >> GRANULE_BITS; g++)
+        m_granules[g].push_back(cpu);
+}
+
+void tlm_exmon::remove_lock(int cpu) {
+    size_t idx = m_slots[cpu] - 1;
+    const range r = m_locks[idx].addr;
+
+    if (num_granules(r) > MAX_GRANULES) {
+        stl_remove(m_wide, cpu);
+    } else {
+        for (u64 g = r.start >> GRANULE_BITS; g <= r.end >> GRANULE_BITS;
+             g++) {
+            auto it = m_granules.find(g);
+            stl_remove(it->second, cpu);
+            if (it->second.empty())
+                m_granules.erase(it);
+        }
+    }
+
+    // move the last lock into the freed slot to keep the list dense
+    if (idx != m_locks.size() - 1) {
+        m_locks[idx] = m_locks.back();
+        m_slots[m_locks[idx].cpu] = idx + 1;
+    }
+
+    m_locks.pop_back();
+    m_slots[cpu] = 0;
+}
+
+const vector<int>& tlm_exmon::find_locks(const range& r) const {
+    m_found.clear();
+    if (m_locks.empty())
+        return m_found;
+
+    if (num_granules(r) > MAX_GRANULES) {
+        for (const exlock& lock : m_locks)
+            if (lock.addr.overlaps(r))
+                m_found.push_back(lock.cpu);
+        return m_found;
+    }
+
+    for (u64 g = r.start >> GRANULE_BITS; g <= r.end >> GRANULE_BITS; g++) {
+        auto it = m_granules.find(g);
+        if (it == m_granules.end())
+            continue;
+
+        for (int cpu : it->second) {
+            const exlock& lock = m_locks[m_slots[cpu] - 1];
+            if (lock.addr.overlaps(r) && !stl_contains(m_found, cpu))
+                m_found.push_back(cpu);
+        }
+    }
+
+    for (int cpu : m_wide) {
+        if (m_locks[m_slots[cpu] - 1].addr.overlaps(r))
+            m_found.push_back(cpu);
+    }
+
+    return m_found;
+}
+
 bool tlm_exmon::has_lock(int cpu, const range& r) const {
-    for (auto lock : m_locks)
-        if (lock.cpu == cpu && lock.addr.includes(r))
-            return true;
-    return false;
+    if (cpu < 0 || (size_t)cpu >= m_slots.size() || !m_slots[cpu])
+        return false;
+    return m_locks[m_slots[cpu] - 1].addr.includes(r);
 }
 
 bool tlm_exmon::add_lock(int cpu, const range& r) {
     assert(cpu >= 0);
     break_locks(cpu);
-    m_locks.push_back({ cpu, r });
+    insert_lock(cpu, r);
     return true;
 }
 
 void tlm_exmon::break_locks(int cpu) {
     assert(cpu >= 0);
-    m_locks.erase(std::remove_if(m_locks.begin(), m_locks.end(),
-                                 [cpu](const exlock& lock) -> bool {
-                                     return lock.cpu == cpu;
-                                 }),
-                  m_locks.end());
+    if ((size_t)cpu < m_slots.size() && m_slots[cpu])
+        remove_lock(cpu);
 }
 
 void tlm_exmon::break_locks(const range& r) {
-    m_locks.erase(std::remove_if(m_locks.begin(), m_locks.end(),
-                                 [r](const exlock& lock) -> bool {
-                                     return lock.addr.overlaps(r);
-                                 }),
-                  m_locks.end());
+    if (m_locks.empty())
+        return;
+
+    for (int cpu : find_locks(r))
+        remove_lock(cpu);
 }
 
 bool tlm_exmon::update(tlm_generic_payload& tx) {
-    for (auto lock : m_locks)
-        if (lock.addr.overlaps(tx))
-            tx.set_dmi_allowed(false);
+    sbiext* ex = tx.get_extension<sbiext>();
+    bool excl = ex != nullptr && ex->is_excl;
+    if (m_locks.empty() && !excl)
+        return true;
+
+    const range addr(tx);
+    if (!find_locks(addr).empty())
+        tx.set_dmi_allowed(false);
 
     bool proceed = true;
-    sbiext* ex = tx.get_extension<sbiext>();
-    if (ex != nullptr && ex->is_excl) {
+    if (excl) {
         if (tx.is_read())
-            add_lock(ex->cpuid, tx);
+            add_lock(ex->cpuid, addr);
         if (tx.is_write())
-            ex->is_excl = has_lock(ex->cpuid, tx);
+            ex->is_excl = has_lock(ex->cpuid, addr);
         proceed = ex->is_excl;
     }
 
     if (tx.is_write())
-        break_locks(tx); // increase range to invalidate entire cache line?
+        break_locks(addr); // increase range to invalidate entire cache line?
 
     return proceed;
 }
 
 bool tlm_exmon::override_dmi(const tlm_generic_payload& tx, tlm_dmi& dmi) {
+    if (m_locks.empty())
+        return true;
+
     for (auto lock : m_locks) {
         if (lock.addr.includes(tx.get_address())) {
             dmi.set_start_address(0);
@@ -16,10 +16,9 @@ namespace vcml {
 unsigned int tlm_host::do_transport(tlm_target_socket& socket,
                                     tlm_generic_payload& tx,
                                     const tlm_sbi& info) {
-    sc_process_b* proc = current_process();
-
-    m_processes[proc].tx = &tx;
-    m_processes[proc].sbi = &info;
+    proc_data& data = process_data(current_process());
+    data.tx = &tx;
+    data.sbi = &info;
 
     if (tx.get_response_status() != TLM_INCOMPLETE_RESPONSE)
         VCML_ERROR("invalid in-bound transaction response status");
@@ -29,8 +28,8 @@ unsigned int tlm_host::do_transport(tlm_target_socket& socket,
     if (tx.get_response_status() == TLM_INCOMPLETE_RESPONSE)
         VCML_ERROR("invalid out-bound transaction response status");
 
-    m_processes[proc].tx = nullptr;
-    m_processes[proc].sbi = nullptr;
+    data.tx = nullptr;
+    data.sbi = nullptr;
 
     return n;
 }
@@ -87,10 +86,7 @@ tlm_host::tlm_host(bool allow_dmi, unsigned int bus_width):
 }
 
 sc_time& tlm_host::local_time(sc_process_b* proc) {
-    if (!stl_contains(m_processes, proc))
-        m_processes[proc].time = SC_ZERO_TIME;
-
-    sc_time& local = m_processes[proc].time;
+    sc_time& local = process_data(proc).time;
     update_local_time(local, proc);
     return local;
 }
@@ -156,9 +152,10 @@ void tlm_host::b_transport(tlm_target_socket& socket, tlm_generic_payload& tx,
                            sc_time& dt) {
     sc_process_b* proc = current_thread();
     VCML_ERROR_ON(!proc, "b_transport outside SC_THREAD");
-    m_processes[proc].time = dt;
+    sc_time& local = process_data(proc).time;
+    local = dt;
     do_transport(socket, tx, socket.current_sideband());
-    dt = m_processes[proc].time;
+    dt = local;
 }
 
 unsigned int tlm_host::transport_dbg(tlm_target_socket& socket,
@@ -0,0 +1,75 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/protocols/tlm_memory.h"
+
+namespace vcml {
+
+void tlm_memory::track_dirty(bool enable) {
+    VCML_ERROR_ON(enable && data() == nullptr, "memory not initialized");
+    if (enable == m_tracking)
+        return;
+
+    m_tracking = enable;
+    m_dirty.clear();
+
+    if (enable) {
+        u64 pages = (m_size + (1ull << DIRTY_PAGE_BITS) - 1) >> DIRTY_PAGE_BITS;
+        m_dirty.resize((pages + 63) / 64, 0);
+    }
+}
+
+bool tlm_memory::is_dirty(const range& addr) const {
+    if (!m_tracking)
+        return false;
+
+    u64 first = addr.start >> DIRTY_PAGE_BITS;
+    u64 last = min<u64>(addr.end >> DIRTY_PAGE_BITS, m_dirty.size() * 64 - 1);
+    for (u64 page = first; page <= last; page++)
+        if (m_dirty[page / 64] & (1ull << (page % 64)))
+            return true;
+
+    return false;
+}
+
+vector<range> tlm_memory::fetch_dirty(bool clear) {
+    vector<range> dirty;
+    if (!m_tracking)
+        return dirty;
+
+    const u64 pagesz = 1ull << DIRTY_PAGE_BITS;
+    for (size_t word = 0; word < m_dirty.size(); word++) {
+        u64 bits = m_dirty[word];
+        if (bits == 0)
+            continue;
+
+        if (clear)
+            m_dirty[word] = 0;
+
+        while (bits) {
+            u64 page = word * 64 + ctz(bits);
+            bits &= bits - 1;
+
+            u64 start = page * pagesz;
+            u64 end = min<u64>(start + pagesz - 1, size() - 1);
+            if (start >= size())
+                break;
+
+            if (!dirty.empty() && dirty.back().end + 1 == start)
+                dirty.back().end = end;
+            else
+                dirty.push_back({ start, end });
+        }
+    }
+
+    return dirty;
+}
+
+} // namespace vcml
@@ -15,8 +15,133 @@
 #include <unistd.h>
 #include <fcntl.h>
 
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
 namespace vcml {
 
+struct tlm_memory::snapshot_image {
+    int fd;
+    size_t size;
+};
+
+static int create_snapshot_file() {
+#ifdef __linux__
+    return memfd_create("vcml_snapshot", MFD_CLOEXEC);
+#else
+    static int count = 0;
+    string name = mkstr("/vcml_snapshot_%d_%d", (int)getpid(), count++);
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0)
+        shm_unlink(name.c_str());
+    return fd;
+#endif
+}
+
+// process-wide cache of image files, files are identified by inode and
+// additionally by content, so that copies of the same blob share one set
+// of page cache pages across all memories that map them
+class image_cache
+{
+private:
+    struct image {
+        int fd;
+        u64 size;
+    };
+
+    mutex m_mtx;
+    unordered_map<string, image*> m_files;
+    unordered_map<u64, vector<image*>> m_sizes;
+
+    static bool same_content(int fd1, int fd2, u64 size);
+
+public:
+    image_cache(): m_mtx(), m_files(), m_sizes() {}
+    ~image_cache();
+
+    int open(const string& filename, u64& size);
+    size_t count();
+
+    static image_cache& instance();
+};
+
+bool image_cache::same_content(int fd1, int fd2, u64 size) {
+    const size_t bufsz = 1 * MiB;
+    vector<u8> buf1(bufsz), buf2(bufsz);
+    for (u64 off = 0; off < size; off += bufsz) {
+        size_t n = min<u64>(bufsz, size - off);
+        if (pread(fd1, buf1.data(), n, off) != (ssize_t)n ||
+            pread(fd2, buf2.data(), n, off) != (ssize_t)n ||
+            memcmp(buf1.data(), buf2.data(), n) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+image_cache::~image_cache() {
+    for (auto& it : m_sizes) {
+        for (image* img : it.second) {
+            close(img->fd);
+            delete img;
+        }
+    }
+}
+
+int image_cache::open(const string& filename, u64& size) {
+    struct stat stat {};
+    if (::stat(filename.c_str(), &stat))
+        return -1;
+
+    string key = mkstr("%llu:%llu:%llu:%lld", (u64)stat.st_dev,
+                       (u64)stat.st_ino, (u64)stat.st_size,
+                       (long long)stat.st_mtime);
+
+    lock_guard<mutex> guard(m_mtx);
+    auto it = m_files.find(key);
+    if (it != m_files.end()) {
+        size = it->second->size;
+        return it->second->fd;
+    }
+
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return -1;
+
+    // contents only need to be compared if another image has the same size
+    size = stat.st_size;
+    for (image* img : m_sizes[size]) {
+        if (same_content(img->fd, fd, size)) {
+            close(fd);
+            m_files[key] = img;
+            return img->fd;
+        }
+    }
+
+    image* img = new image{ fd, size };
+    m_sizes[size].push_back(img);
+    m_files[key] = img;
+    return fd;
+}
+
+size_t image_cache::count() {
+    lock_guard<mutex> guard(m_mtx);
+    size_t n = 0;
+    for (const auto& it : m_sizes)
+        n += it.second.size();
+    return n;
+}
+
+image_cache& image_cache::instance() {
+    static image_cache cache;
+    return cache;
+}
+
+static bool is_zero_page(const u8* page, size_t size) {
+    return page[0] == 0 && memcmp(page, page + 1, size - 1) == 0;
+}
+
 int tlm_memory::init_shared(const string& shared, size_t size) {
     VCML_ERROR_ON(is_shared(), "shared memory already initialized");
     m_shared = shared;
@@ -48,7 +173,19 @@ int tlm_memory::init_shared(const string& shared, size_t size) {
 }
 
 tlm_memory::tlm_memory():
-    tlm_dmi(), m_handle(), m_base(), m_size(0), m_discard(false), m_shared() {
+    tlm_dmi(),
+    m_handle(),
+    m_base(),
+    m_size(0),
+    m_discard(false),
+    m_hugetlb(false),
+    m_hugepages(false),
+    m_prefaulted(false),
+    m_numa_node(-1),
+    m_shared(),
+    m_snapshots(),
+    m_tracking(false),
+    m_dirty() {
 }
 
 tlm_memory::tlm_memory(size_t size): tlm_memory() {
@@ -73,7 +210,15 @@ tlm_memory::tlm_memory(tlm_memory&& other) noexcept:
     m_handle(other.m_handle),
     m_base(other.m_base),
     m_size(other.m_size),
-    m_discard(other.m_discard) {
+    m_discard(other.m_discard),
+    m_hugetlb(other.m_hugetlb),
+    m_hugepages(other.m_hugepages),
+    m_prefaulted(other.m_prefaulted),
+    m_numa_node(other.m_numa_node),
+    m_snapshots(std::move(other.m_snapshots)),
+    m_tracking(other.m_tracking),
+    m_dirty(std::move(other.m_dirty)) {
+    other.m_snapshots.clear();
     other.m_handle = nullptr;
     other.m_base = nullptr;
     other.m_size = 0;
@@ -84,7 +229,8 @@ tlm_memory::~tlm_memory() {
     free();
 }
 
-void tlm_memory::init(const string& shared, size_t size, alignment al) {
+void tlm_memory::init(const string& shared, size_t size, alignment al,
+                      bool hugetlb) {
     VCML_ERROR_ON(m_size, "memory already initialized");
 
     // mmap automatically aligns up to 4k, for larger alignments we
@@ -103,7 +249,21 @@ void tlm_memory::init(const string& shared, size_t size, alignment al) {
     else
         flags |= MAP_PRIVATE | MAP_ANON;
 
-    m_base = mmap(0, m_size, perms, flags, fd, 0);
+    m_base = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (hugetlb && !is_shared()) {
+        size_t hpsz = 1ull << VCML_ALIGN_2M;
+        size_t hpsize = (m_size + hpsz - 1) & ~(hpsz - 1);
+        m_base = mmap(0, hpsize, perms, flags | MAP_HUGETLB, fd, 0);
+        if (m_base != MAP_FAILED)
+            m_size = hpsize;
+    }
+#endif
+
+    m_hugetlb = m_base != MAP_FAILED;
+    if (m_base == MAP_FAILED)
+        m_base = mmap(0, m_size, perms, flags, fd, 0);
+
     VCML_ERROR_ON(m_base == MAP_FAILED, "mmap failed: %s", strerror(errno));
     u8* ptr = (u8*)(((u64)m_base + extra) & ~extra);
     VCML_ERROR_ON(!is_aligned(ptr, al), "memory alignment failed");
@@ -116,6 +276,9 @@ void tlm_memory::init(const string& shared, size_t size, alignment al) {
 }
 
 void tlm_memory::free() {
+    while (!m_snapshots.empty())
+        drop_snapshot(m_snapshots.begin()->first);
+
     if (m_base != nullptr) {
         int ret = munmap(m_base, m_size);
         VCML_ERROR_ON(ret, "munmap failed: %d", ret);
@@ -127,10 +290,180 @@ void tlm_memory::free() {
     m_shared = "";
     m_base = nullptr;
     m_size = 0;
+    m_hugetlb = false;
+    m_hugepages = false;
+    m_prefaulted = false;
+    m_numa_node = -1;
+    m_tracking = false;
+    m_dirty.clear();
 
     tlm_dmi::init();
 }
 
+bool tlm_memory::use_hugepages() {
+    VCML_ERROR_ON(data() == nullptr, "memory not initialized");
+#ifdef MADV_HUGEPAGE
+    if (!m_hugepages && !m_hugetlb)
+        m_hugepages = madvise(data(), size(), MADV_HUGEPAGE) == 0;
+#endif
+    return m_hugepages || m_hugetlb;
+}
+
+bool tlm_memory::bind_numa(unsigned int node) {
+    VCML_ERROR_ON(data() == nullptr, "memory not initialized");
+#if defined(__linux__) && defined(SYS_mbind)
+    const unsigned long mpol_bind = 2;
+    const unsigned long mpol_mf_move = 1ul << 1;
+    const size_t bits = 8 * sizeof(unsigned long);
+
+    vector<unsigned long> mask(node / bits + 1, 0);
+    mask[node / bits] = 1ul << (node % bits);
+    long res = syscall(SYS_mbind, data(), size(), mpol_bind, mask.data(),
+                       mask.size() * bits + 1, mpol_mf_move);
+    if (res == 0)
+        m_numa_node = node;
+    return res == 0;
+#else
+    return false;
+#endif
+}
+
+bool tlm_memory::prefault() {
+    VCML_ERROR_ON(data() == nullptr, "memory not initialized");
+    if (m_prefaulted)
+        return true;
+
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(data(), size(), MADV_POPULATE_WRITE) == 0)
+        return m_prefaulted = true;
+#endif
+
+    // older kernels: touch every page, preserving its contents
+    size_t pagesz = (size_t)sysconf(_SC_PAGESIZE);
+    for (size_t off = 0; off < size(); off += pagesz) {
+        volatile u8* page = data() + off;
+        *page = *page;
+    }
+
+    return m_prefaulted = true;
+}
+
+bool tlm_memory::map_file(const string& filename, u64 offset) {
+    VCML_ERROR_ON(data() == nullptr, "memory not initialized");
+    if (is_shared() || m_hugetlb)
+        return false;
+
+    size_t pagesz = (size_t)sysconf(_SC_PAGESIZE);
+    if (offset % pagesz)
+        return false;
+
+    u64 filesize = 0;
+    int fd = image_cache::instance().open(filename, filesize);
+    if (fd < 0 || offset + filesize > size())
+        return false;
+
+    // only whole pages are mapped, the remainder is read as usual to
+    // keep the rest of the last page intact
+    size_t length = filesize & ~(pagesz - 1);
+    size_t tail = filesize - length;
+    u8* dest = data() + offset;
+
+    if (length > 0) {
+        int perms = PROT_READ | PROT_WRITE;
+        int flags = MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE;
+        void* ptr = mmap(dest, length, perms, flags, fd, 0);
+        VCML_ERROR_ON(ptr == MAP_FAILED, "mmap failed: %s", strerror(errno));
+
+        // the remapped pages do not inherit any placement hints
+        m_hugepages = false;
+        m_prefaulted = false;
+        m_numa_node = -1;
+    }
+
+    if (tail > 0 && pread(fd, dest + length, tail, length) != (ssize_t)tail)
+        VCML_ERROR("cannot read '%s': %s", filename.c_str(), strerror(errno));
+
+    mark_dirty({ offset, offset + filesize - 1 });
+    return true;
+}
+
+size_t tlm_memory::cached_images() {
+    return image_cache::instance().count();
+}
+
+void tlm_memory::map_snapshot(const snapshot_image& image) {
+    // a private mapping of the snapshot file makes the memory copy-on-write
+    int perms = PROT_READ | PROT_WRITE;
+    int flags = MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE;
+    void* ptr = mmap(data(), image.size, perms, flags, image.fd, 0);
+    VCML_ERROR_ON(ptr == MAP_FAILED, "mmap failed: %s", strerror(errno));
+
+    // the new mapping does not inherit any placement hints
+    m_hugepages = false;
+    m_prefaulted = false;
+    m_numa_node = -1;
+}
+
+vector<string> tlm_memory::snapshots() const {
+    vector<string> names;
+    for (const auto& it : m_snapshots)
+        names.push_back(it.first);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool tlm_memory::snapshot(const string& name) {
+    VCML_ERROR_ON(data() == nullptr, "memory not initialized");
+    if (is_shared() || m_hugetlb)
+        return false;
+
+    size_t pagesz = (size_t)sysconf(_SC_PAGESIZE);
+    size_t length = (size() + pagesz - 1) & ~(pagesz - 1);
+
+    int fd = create_snapshot_file();
+    VCML_ERROR_ON(fd < 0, "cannot create snapshot: %s", strerror(errno));
+    VCML_ERROR_ON(ftruncate(fd, length), "ftruncate: %s", strerror(errno));
+
+    // zero pages are left as holes in the snapshot file
+    for (size_t off = 0; off < size(); off += pagesz) {
+        size_t n = min(pagesz, size() - off);
+        if (is_zero_page(data() + off, n))
+            continue;
+
+        if (pwrite(fd, data() + off, n, off) != (ssize_t)n) {
+            close(fd);
+            VCML_ERROR("cannot write snapshot: %s", strerror(errno));
+        }
+    }
+
+    drop_snapshot(name);
+    snapshot_image* image = new snapshot_image{ fd, length };
+    m_snapshots[name] = image;
+    map_snapshot(*image);
+    return true;
+}
+
+bool tlm_memory::restore(const string& name) {
+    auto it = m_snapshots.find(name);
+    if (it == m_snapshots.end() || is_shared() || m_hugetlb)
+        return false;
+
+    map_snapshot(*it->second);
+    mark_dirty({ 0, size() - 1 });
+    return true;
+}
+
+void tlm_memory::drop_snapshot(const string& name) {
+    auto it = m_snapshots.find(name);
+    if (it == m_snapshots.end())
+        return;
+
+    // active mappings keep their own reference to the snapshot file
+    close(it->second->fd);
+    delete it->second;
+    m_snapshots.erase(it);
+}
+
 tlm_response_status tlm_memory::fill(u8 data, bool debug) {
     if (!is_write_allowed() && !debug)
         return m_discard ? TLM_OK_RESPONSE : TLM_COMMAND_ERROR_RESPONSE;
@@ -165,6 +498,7 @@ tlm_response_status tlm_memory::write(const range& addr, const void* src,
     }
 
     memcpy(data() + addr.start, src, addr.length());
+    mark_dirty(addr);
     return TLM_OK_RESPONSE;
 }
 
@@ -14,6 +14,10 @@
 
 namespace vcml {
 
+struct tlm_memory::snapshot_image {
+    vector<u8> data;
+};
+
 int tlm_memory::init_shared(const string& shared, size_t size) {
     VCML_ERROR_ON(is_shared(), "shared memory already initialized");
     m_shared = shared;
@@ -48,7 +52,14 @@ tlm_memory::tlm_memory():
     m_base(nullptr),
     m_size(0),
     m_discard(false),
-    m_shared() {
+    m_hugetlb(false),
+    m_hugepages(false),
+    m_prefaulted(false),
+    m_numa_node(-1),
+    m_shared(),
+    m_snapshots(),
+    m_tracking(false),
+    m_dirty() {
 }
 
 tlm_memory::tlm_memory(size_t size): tlm_memory() {
@@ -73,7 +84,15 @@ tlm_memory::tlm_memory(tlm_memory&& other) noexcept:
     m_handle(other.m_handle),
     m_base(other.m_base),
     m_size(other.m_size),
-    m_discard(other.m_discard) {
+    m_discard(other.m_discard),
+    m_hugetlb(other.m_hugetlb),
+    m_hugepages(other.m_hugepages),
+    m_prefaulted(other.m_prefaulted),
+    m_numa_node(other.m_numa_node),
+    m_snapshots(std::move(other.m_snapshots)),
+    m_tracking(other.m_tracking),
+    m_dirty(std::move(other.m_dirty)) {
+    other.m_snapshots.clear();
     other.m_handle = INVALID_HANDLE_VALUE;
     other.m_base = nullptr;
     other.m_size = 0;
@@ -84,7 +103,8 @@ tlm_memory::~tlm_memory() {
     free();
 }
 
-void tlm_memory::init(const string& shared, size_t size, alignment al) {
+void tlm_memory::init(const string& shared, size_t size, alignment al,
+                      bool hugetlb) {
     VCML_ERROR_ON(m_size, "memory already initialized");
 
     // mmap automatically aligns up to 4k, for larger alignments we
@@ -110,6 +130,9 @@ void tlm_memory::init(const string& shared, size_t size, alignment al) {
 }
 
 void tlm_memory::free() {
+    while (!m_snapshots.empty())
+        drop_snapshot(m_snapshots.begin()->first);
+
     if (m_handle) {
         if (m_base)
             UnmapViewOfFile(m_base);
@@ -124,10 +147,88 @@ void tlm_memory::free() {
 
     m_shared = "";
     m_size = 0;
+    m_prefaulted = false;
+    m_tracking = false;
+    m_dirty.clear();
 
     tlm_dmi::init();
 }
 
+bool tlm_memory::use_hugepages() {
+    return false; // large pages require special privileges on windows
+}
+
+bool tlm_memory::bind_numa(unsigned int node) {
+    return false;
+}
+
+bool tlm_memory::prefault() {
+    VCML_ERROR_ON(data() == nullptr, "memory not initialized");
+    if (m_prefaulted)
+        return true;
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    for (size_t off = 0; off < size(); off += info.dwPageSize) {
+        volatile u8* page = data() + off;
+        *page = *page;
+    }
+
+    return m_prefaulted = true;
+}
+
+bool tlm_memory::map_file(const string& filename, u64 offset) {
+    return false; // views cannot be mapped into an existing allocation
+}
+
+size_t tlm_memory::cached_images() {
+    return 0;
+}
+
+void tlm_memory::map_snapshot(const snapshot_image& image) {
+    // no copy-on-write mappings available, fall back to copying
+    memcpy(data(), image.data.data(), image.data.size());
+}
+
+vector<string> tlm_memory::snapshots() const {
+    vector<string> names;
+    for (const auto& it : m_snapshots)
+        names.push_back(it.first);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool tlm_memory::snapshot(const string& name) {
+    VCML_ERROR_ON(data() == nullptr, "memory not initialized");
+    if (is_shared())
+        return false;
+
+    drop_snapshot(name);
+    snapshot_image* image = new snapshot_image;
+    image->data.assign(data(), data() + size());
+    m_snapshots[name] = image;
+    return true;
+}
+
+bool tlm_memory::restore(const string& name) {
+    auto it = m_snapshots.find(name);
+    if (it == m_snapshots.end() || is_shared())
+        return false;
+
+    map_snapshot(*it->second);
+    mark_dirty({ 0, size() - 1 });
+    return true;
+}
+
+void tlm_memory::drop_snapshot(const string& name) {
+    auto it = m_snapshots.find(name);
+    if (it == m_snapshots.end())
+        return;
+
+    delete it->second;
+    m_snapshots.erase(it);
+}
+
 tlm_response_status tlm_memory::fill(u8 data, bool debug) {
     if (!is_write_allowed() && !debug)
         return m_discard ? TLM_OK_RESPONSE : TLM_COMMAND_ERROR_RESPONSE;
@@ -162,6 +263,7 @@ tlm_response_status tlm_memory::write(const range& addr, const void* src,
     }
 
     memcpy(data() + addr.start, src, addr.length());
+    mark_dirty(addr);
     return TLM_OK_RESPONSE;
 }
 
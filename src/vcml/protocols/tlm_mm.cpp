@@ -0,0 +1,75 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/protocols/tlm_mm.h"
+
+namespace vcml {
+
+tlm_mm::tlm_mm():
+    tlm::tlm_mm_interface(),
+    m_mtx(),
+    m_pool(),
+    m_allocations(0),
+    m_reuses(0),
+    m_in_use(0) {
+    // nothing to do
+}
+
+tlm_mm::~tlm_mm() {
+    for (tlm_generic_payload* tx : m_pool)
+        delete tx;
+}
+
+tlm_generic_payload* tlm_mm::allocate() {
+    tlm_generic_payload* tx = nullptr;
+
+    {
+        lock_guard<mutex> guard(m_mtx);
+        m_in_use++;
+        if (!m_pool.empty()) {
+            tx = m_pool.back();
+            m_pool.pop_back();
+            m_reuses++;
+        } else {
+            m_allocations++;
+        }
+    }
+
+    if (tx == nullptr) {
+        tx = new tlm_generic_payload(this);
+        tx->set_extension(new sbiext());
+    }
+
+    tx_setup(*tx, TLM_IGNORE_COMMAND, 0, nullptr, 0);
+    tx->acquire();
+    return tx;
+}
+
+void tlm_mm::free(tlm_generic_payload* tx) {
+    // drop everything but the sbiext that was attached upon allocation
+    sbiext* ext = tx->get_extension<sbiext>();
+    if (ext)
+        tx->clear_extension(ext);
+    tx->free_all_extensions();
+    tx->set_extension(ext ? ext : new sbiext());
+    tx->get_extension<sbiext>()->copy(SBI_NONE);
+
+    lock_guard<mutex> guard(m_mtx);
+    VCML_ERROR_ON(m_in_use == 0, "payload released to wrong memory manager");
+    m_pool.push_back(tx);
+    m_in_use--;
+}
+
+tlm_mm& tlm_mm::instance() {
+    static tlm_mm mm;
+    return mm;
+}
+
+} // namespace vcml
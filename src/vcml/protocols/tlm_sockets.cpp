@@ -26,10 +26,11 @@ void tlm_initiator_socket::invalidate_direct_mem_ptr(u64 start, u64 end) {
 tlm_initiator_socket::tlm_initiator_socket(const char* nm,
                                            address_space space):
     simple_initiator_socket<tlm_initiator_socket>(nm),
-    m_tx(),
-    m_txd(),
+    m_tx(*tlm_mm::instance().allocate()),
+    m_txd(*tlm_mm::instance().allocate()),
     m_sbi(SBI_NONE),
     m_dmi_cache(),
+    m_bounce(),
     m_stub(nullptr),
     m_host(hierarchy_search<tlm_host>()),
     m_parent(hierarchy_search<module>()),
@@ -48,9 +49,6 @@ tlm_initiator_socket::tlm_initiator_socket(const char* nm,
 
     register_invalidate_direct_mem_ptr(
         this, &tlm_initiator_socket::invalidate_direct_mem_ptr_int);
-
-    m_tx.set_extension(new sbiext());
-    m_txd.set_extension(new sbiext());
 }
 
 tlm_initiator_socket::~tlm_initiator_socket() {
@@ -60,6 +58,9 @@ tlm_initiator_socket::~tlm_initiator_socket() {
         delete m_stub;
     if (m_dmi_cache)
         delete m_dmi_cache;
+
+    m_txd.release();
+    m_tx.release();
 }
 
 u8* tlm_initiator_socket::lookup_dmi_ptr(const range& mem, vcml_access rw) {
@@ -70,10 +71,10 @@ u8* tlm_initiator_socket::lookup_dmi_ptr(const range& mem, vcml_access rw) {
     if (dmi_cache().lookup(mem, rw, dmi))
         return dmi_get_ptr(dmi, mem.start);
 
-    tlm_generic_payload tx;
+    tlm_pooled_payload tx;
     tlm_command cmd = tlm_command_from_access(rw);
-    tx_setup(tx, cmd, mem.start, nullptr, mem.length());
-    if (!(*this)->get_direct_mem_ptr(tx, dmi))
+    tx_setup(*tx, cmd, mem.start, nullptr, mem.length());
+    if (!(*this)->get_direct_mem_ptr(*tx, dmi))
         return nullptr;
 
     map_dmi(dmi);
@@ -97,6 +98,13 @@ void tlm_initiator_socket::b_transport(tlm_generic_payload& tx, sc_time& t) {
 
 unsigned int tlm_initiator_socket::send(tlm_generic_payload& tx,
                                         const tlm_sbi& info) try {
+    // parallel processors funnel regular transactions through the kernel
+    if (!info.is_debug && sc_is_async()) {
+        unsigned int bytes = 0;
+        sc_sync([&]() { bytes = send(tx, info); });
+        return bytes;
+    }
+
     unsigned int bytes = 0;
     unsigned int size = tx.get_data_length();
     unsigned int width = tx.get_streaming_width();
@@ -168,13 +176,18 @@ tlm_response_status tlm_initiator_socket::access_dmi(tlm_command cmd, u64 addr,
     if (info.is_nodmi || info.is_excl)
         return TLM_INCOMPLETE_RESPONSE;
 
+    // debug writes need write permission as well, so that targets that
+    // withhold write DMI still see them, e.g. to track dirty memory
     tlm_dmi dmi;
-    tlm_command elevate = info.is_debug ? TLM_READ_COMMAND : cmd;
-    if (!dmi_cache().lookup(addr, size, elevate, dmi))
+    if (!dmi_cache().lookup(addr, size, cmd, dmi))
         return TLM_INCOMPLETE_RESPONSE;
 
-    if (info.is_sync && !info.is_debug)
+    if (info.is_sync && !info.is_debug) {
+        // synchronizing accesses must be run from within the kernel
+        if (sc_is_async())
+            return TLM_INCOMPLETE_RESPONSE;
         m_host->sync();
+    }
 
     sc_time latency = SC_ZERO_TIME;
     if (cmd == TLM_READ_COMMAND) {
@@ -199,7 +212,7 @@ tlm_response_status tlm_initiator_socket::access(tlm_command cmd, u64 addr,
                                                  const tlm_sbi& info,
                                                  unsigned int* sz) {
     // TLM protocol sanity checking
-    if (!info.is_debug && !is_thread())
+    if (!info.is_debug && !is_thread() && !sc_is_async())
         VCML_ERROR("non-debug TLM access outside SC_THREAD forbidden");
 
     // check if we are allowed to do a DMI access on that address
@@ -230,6 +243,120 @@ tlm_response_status tlm_initiator_socket::access(tlm_command cmd, u64 addr,
     return rs;
 }
 
+tlm_response_status tlm_initiator_socket::accessv(tlm_command cmd,
+                                                  const vector<tlm_iovec>& iov,
+                                                  const tlm_sbi& info,
+                                                  unsigned int* sz) {
+    // TLM protocol sanity checking
+    if (!info.is_debug && !is_thread() && !sc_is_async())
+        VCML_ERROR("non-debug TLM access outside SC_THREAD forbidden");
+
+    // synchronizing accesses must be run from within the kernel
+    const bool sync = info.is_sync && !info.is_debug;
+    const bool use_dmi = allow_dmi && cmd != TLM_IGNORE_COMMAND &&
+                         !info.is_nodmi && !info.is_excl &&
+                         !(sync && sc_is_async());
+
+    tlm_response_status rs = TLM_OK_RESPONSE;
+    sc_time latency = SC_ZERO_TIME;
+    unsigned int bytes = 0;
+    bool pending = false; // dmi accesses not yet accounted for
+
+    size_t i = 0;
+    while (i < iov.size() && success(rs)) {
+        if (iov[i].size == 0) {
+            i++;
+            continue;
+        }
+
+        // collect all following entries that continue in guest memory
+        const u64 start = iov[i].addr;
+        u64 length = iov[i].size;
+        bool linear = true;
+        size_t j = i + 1;
+        for (; j < iov.size() && iov[j].addr == start + length; j++) {
+            if (length + iov[j].size > ~0u)
+                break;
+            const u8* prev = (const u8*)iov[j - 1].data + iov[j - 1].size;
+            linear &= iov[j].size == 0 || iov[j].data == prev;
+            length += iov[j].size;
+        }
+
+        tlm_dmi dmi;
+        if (use_dmi && dmi_cache().lookup(start, length, cmd, dmi)) {
+            if (sync) {
+                m_host->local_time() += latency;
+                latency = SC_ZERO_TIME;
+                m_host->sync();
+            }
+
+            for (size_t k = i; k < j; k++) {
+                u8* ptr = dmi_get_ptr(dmi, iov[k].addr);
+                if (cmd == TLM_READ_COMMAND)
+                    memcpy(iov[k].data, ptr, iov[k].size);
+                else
+                    memcpy(ptr, iov[k].data, iov[k].size);
+            }
+
+            latency += cmd == TLM_READ_COMMAND ? dmi.get_read_latency()
+                                               : dmi.get_write_latency();
+            pending = true;
+            bytes += length;
+            i = j;
+            continue;
+        }
+
+        // account pending DMI latency before handing out time to targets
+        if (!info.is_debug && latency != SC_ZERO_TIME) {
+            m_host->local_time() += latency;
+            latency = SC_ZERO_TIME;
+        }
+
+        pending = false;
+
+        u8* data = (u8*)iov[i].data;
+        if (!linear) {
+            m_bounce.resize(length);
+            data = m_bounce.data();
+            if (cmd == TLM_WRITE_COMMAND) {
+                for (size_t k = i; k < j; k++)
+                    memcpy(data + iov[k].addr - start, iov[k].data,
+                           iov[k].size);
+            }
+        }
+
+        auto& tx = info.is_debug ? m_txd : m_tx;
+        tx_setup(tx, cmd, start, data, length);
+        bytes += send(tx, info);
+
+        // transport_dbg does not always change response status
+        rs = tx.get_response_status();
+        if (rs == TLM_INCOMPLETE_RESPONSE && info.is_debug)
+            rs = TLM_OK_RESPONSE;
+
+        if (rs == TLM_INCOMPLETE_RESPONSE)
+            m_parent->log_warn("got incomplete response from 0x%016llx", start);
+
+        if (!linear && cmd == TLM_READ_COMMAND && success(rs)) {
+            for (size_t k = i; k < j; k++)
+                memcpy(iov[k].data, data + iov[k].addr - start, iov[k].size);
+        }
+
+        i = j;
+    }
+
+    if (!info.is_debug && pending) {
+        m_host->local_time() += latency;
+        if (info.is_sync)
+            m_host->sync();
+    }
+
+    if (sz != nullptr)
+        *sz = bytes;
+
+    return rs;
+}
+
 void tlm_initiator_socket::stub(tlm_response_status r) {
     VCML_ERROR_ON(m_stub, "socket %s already stubbed", name());
     hierarchy_guard guard(m_parent);
@@ -0,0 +1,233 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/protocols/tlm_sparse_memory.h"
+
+#ifdef _MSC_VER
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace vcml {
+
+// pages are mapped directly from the host, which hands out zero pages and
+// only commits memory for the parts of a page the guest actually touches
+static void* alloc_page() {
+    const size_t size = tlm_sparse_memory::PAGE_SIZE;
+#ifdef _MSC_VER
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT,
+                        PAGE_READWRITE);
+#else
+    int prot = PROT_READ | PROT_WRITE;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+    void* page = mmap(nullptr, size, prot, flags, -1, 0);
+    return page != MAP_FAILED ? page : nullptr;
+#endif
+}
+
+static void free_page(void* page) {
+#ifdef _MSC_VER
+    VirtualFree(page, 0, MEM_RELEASE);
+#else
+    munmap(page, tlm_sparse_memory::PAGE_SIZE);
+#endif
+}
+
+static unsigned int sparse_levels(u64 size) {
+    const u64 npages = (size + tlm_sparse_memory::PAGE_SIZE - 1) >>
+                       tlm_sparse_memory::PAGE_BITS;
+
+    unsigned int levels = 1;
+    while (levels * tlm_sparse_memory::TABLE_BITS < 64 &&
+           (npages - 1) >> (levels * tlm_sparse_memory::TABLE_BITS))
+        levels++;
+    return levels;
+}
+
+void tlm_sparse_memory::free_table(table* tab, unsigned int level) {
+    if (tab == nullptr)
+        return;
+
+    for (void* entry : tab->entries) {
+        if (entry == nullptr)
+            continue;
+
+        if (level + 1 < m_levels) {
+            free_table((table*)entry, level + 1);
+        } else {
+            free_page(entry);
+            m_pages--;
+        }
+    }
+
+    delete tab;
+    m_tables--;
+}
+
+void tlm_sparse_memory::collect(const table* tab, unsigned int level,
+                                u64 page, vector<u64>& pages) const {
+    for (size_t i = 0; i < TABLE_SIZE; i++) {
+        void* entry = tab->entries[i];
+        if (entry == nullptr)
+            continue;
+
+        u64 next = (page << TABLE_BITS) | i;
+        if (level + 1 < m_levels)
+            collect((const table*)entry, level + 1, next, pages);
+        else
+            pages.push_back(next << PAGE_BITS);
+    }
+}
+
+tlm_sparse_memory::tlm_sparse_memory(u64 size):
+    m_size(size),
+    m_levels(sparse_levels(size)),
+    m_root(nullptr),
+    m_readonly(false),
+    m_discard(false),
+    m_pages(0),
+    m_tables(0) {
+    VCML_ERROR_ON(size == 0, "sparse memory size cannot be zero");
+}
+
+tlm_sparse_memory::~tlm_sparse_memory() {
+    clear();
+}
+
+u8* tlm_sparse_memory::populate(u64 addr) {
+    VCML_ERROR_ON(addr >= m_size, "address out of bounds: 0x%llx", addr);
+    if (u8* ptr = lookup(addr))
+        return ptr;
+
+    const u64 page = addr >> PAGE_BITS;
+    if (m_root == nullptr) {
+        m_root = new table();
+        m_tables++;
+    }
+
+    table* tab = m_root;
+    for (unsigned int lvl = 0; lvl + 1 < m_levels; lvl++) {
+        void*& entry = tab->entries[table_index(page, lvl)];
+        if (entry == nullptr) {
+            entry = new table();
+            m_tables++;
+        }
+
+        tab = (table*)entry;
+    }
+
+    void*& entry = tab->entries[table_index(page, m_levels - 1)];
+    entry = alloc_page();
+    VCML_ERROR_ON(!entry, "failed to allocate sparse memory page");
+    m_pages++;
+
+    return (u8*)entry + (addr & (PAGE_SIZE - 1));
+}
+
+void tlm_sparse_memory::clear() {
+    free_table(m_root, 0);
+    m_root = nullptr;
+}
+
+vector<u64> tlm_sparse_memory::resident() const {
+    vector<u64> pages;
+    pages.reserve(m_pages);
+    if (m_root != nullptr)
+        collect(m_root, 0, 0, pages);
+    return pages;
+}
+
+bool tlm_sparse_memory::get_dmi(u64 addr, tlm_dmi& dmi) const {
+    u64 start = addr & ~(PAGE_SIZE - 1);
+    u8* ptr = lookup(start);
+    if (ptr == nullptr)
+        return false;
+
+    dmi.init();
+    dmi.set_dmi_ptr(ptr);
+    dmi.set_start_address(start);
+    dmi.set_end_address(min(start + PAGE_SIZE, m_size) - 1);
+    if (m_readonly || m_discard)
+        dmi.allow_read();
+    else
+        dmi.allow_read_write();
+    return true;
+}
+
+tlm_response_status tlm_sparse_memory::read(const range& addr, void* dest,
+                                            bool debug) const {
+    if (addr.end >= m_size)
+        return TLM_ADDRESS_ERROR_RESPONSE;
+
+    u8* dst = (u8*)dest;
+    for (u64 pos = addr.start; pos <= addr.end;) {
+        u64 n = min(addr.end - pos + 1, PAGE_SIZE - (pos & (PAGE_SIZE - 1)));
+        if (const u8* src = lookup(pos))
+            memcpy(dst, src, n);
+        else
+            memset(dst, 0, n);
+
+        dst += n;
+        pos += n;
+    }
+
+    return TLM_OK_RESPONSE;
+}
+
+tlm_response_status tlm_sparse_memory::write(const range& addr,
+                                             const void* src, bool debug) {
+    if (addr.end >= m_size)
+        return TLM_ADDRESS_ERROR_RESPONSE;
+
+    if (!debug) {
+        if (m_discard)
+            return TLM_OK_RESPONSE;
+        if (m_readonly)
+            return TLM_COMMAND_ERROR_RESPONSE;
+    }
+
+    const u8* ptr = (const u8*)src;
+    for (u64 pos = addr.start; pos <= addr.end;) {
+        u64 n = min(addr.end - pos + 1, PAGE_SIZE - (pos & (PAGE_SIZE - 1)));
+        u8* dst = lookup(pos);
+
+        // writing zeros to untouched pages does not need a new page
+        if (dst == nullptr && ptr[0] == 0 && !memcmp(ptr, ptr + 1, n - 1)) {
+            ptr += n;
+            pos += n;
+            continue;
+        }
+
+        if (dst == nullptr)
+            dst = populate(pos);
+
+        memcpy(dst, ptr, n);
+        ptr += n;
+        pos += n;
+    }
+
+    return TLM_OK_RESPONSE;
+}
+
+void tlm_sparse_memory::transport(tlm_generic_payload& tx,
+                                  const tlm_sbi& sbi) {
+    tlm_response_status res = TLM_OK_RESPONSE;
+    range addr(tx);
+
+    if (tx.is_read())
+        res = read(addr, tx.get_data_ptr(), sbi.is_debug);
+    if (tx.is_write())
+        res = write(addr, tx.get_data_ptr(), sbi.is_debug);
+
+    tx.set_response_status(res);
+}
+
+} // namespace vcml
@@ -0,0 +1,65 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#include "vcml.h"
+
+using namespace vcml;
+
+// measures sc_sync round trip latency and host cpu load while the kernel
+// is busy servicing requests, once spinning only and once spin-then-block
+class async_bench : public component
+{
+public:
+    async_bench(const sc_module_name& nm): component(nm) {
+        rst.stub();
+        clk.stub(10 * MHz);
+        SC_HAS_PROCESS(async_bench);
+        SC_THREAD(run);
+    }
+
+    void handoff(size_t spin_limit, const char* mode) {
+        const size_t n = 200;
+        set_async_spin_limit(spin_limit);
+
+        double t0 = mwr::timestamp();
+        clock_t c0 = clock();
+        sc_async([&]() -> void {
+            for (size_t i = 0; i < n; i++)
+                sc_sync([&]() -> void { mwr::usleep(100); });
+        });
+        double busy = mwr::timestamp() - t0;
+        double load = (double)(clock() - c0) / CLOCKS_PER_SEC / busy;
+
+        t0 = mwr::timestamp();
+        sc_async([&]() -> void {
+            for (size_t i = 0; i < n; i++)
+                sc_sync([&]() -> void {});
+        });
+        double latency = (mwr::timestamp() - t0) / n;
+
+        std::cout << mode << ": " << latency * 1e6 << "us per sc_sync, "
+                  << load * 100.0 << "% cpu while waiting" << std::endl;
+    }
+
+    void run() {
+        size_t limit = async_spin_limit();
+        handoff(SIZE_MAX, "spin");
+        handoff(limit, "spin-then-block");
+        set_async_spin_limit(limit);
+        sc_stop();
+    }
+};
+
+extern "C" int sc_main(int argc, char** argv) {
+    async_bench bench("bench");
+    sc_start();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,56 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml.h"
+
+// average lookup time in nanoseconds, either always hitting the same region
+// or spreading lookups over all cached regions
+static double lookup_ns(size_t entries, bool repeat) {
+    static unsigned char dummy[4096];
+    const size_t lookups = 1000000;
+
+    vcml::tlm_dmi_cache cache;
+    cache.set_entry_limit(entries);
+    for (size_t i = 0; i < entries; i++) {
+        tlm::tlm_dmi dmi;
+        dmi.allow_read_write();
+        dmi.set_start_address(i * 0x2000);
+        dmi.set_end_address(i * 0x2000 + 0xfff);
+        dmi.set_dmi_ptr(dummy);
+        cache.insert(dmi);
+    }
+
+    size_t hits = 0;
+    tlm::tlm_dmi dmi;
+    double t0 = mwr::timestamp();
+    for (size_t i = 0; i < lookups; i++) {
+        size_t idx = repeat ? entries / 2 : (i * 7919) % entries;
+        if (cache.lookup(idx * 0x2000 + 8, 4, tlm::TLM_READ_COMMAND, dmi))
+            hits++;
+    }
+
+    double t1 = mwr::timestamp();
+    if (hits != lookups)
+        std::cerr << "unexpected misses: " << lookups - hits << std::endl;
+
+    return (t1 - t0) * 1e9 / lookups;
+}
+
+extern "C" int sc_main(int argc, char** argv) {
+    for (size_t entries : { 16, 256, 4096 }) {
+        double hit = lookup_ns(entries, true);
+        double miss = lookup_ns(entries, false);
+        std::cout << "lookup with " << entries << " entries: " << hit
+                  << "ns (same region), " << miss << "ns (random region)"
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#include "vcml.h"
+
+// average time per exclusive access with all cpus spinning on their own
+// lock word while cpu 0 also competes for the lock of cpu 1
+static double exclusive_ns(int ncpus, int rounds) {
+    vcml::tlm_exmon mon;
+    vcml::sbiext ex;
+    tlm::tlm_generic_payload tx;
+    vcml::u32 data = 0;
+    tx.set_data_ptr((unsigned char*)&data);
+    tx.set_data_length(sizeof(data));
+    tx.set_streaming_width(sizeof(data));
+    tx.set_extension(&ex);
+
+    size_t succeeded = 0;
+    double t0 = mwr::timestamp();
+    for (int i = 0; i < rounds; i++) {
+        for (int cpu = 0; cpu < ncpus; cpu++) {
+            ex.cpuid = cpu;
+            ex.is_excl = true;
+            tx.set_address(cpu * 8);
+            tx.set_read();
+            mon.update(tx);
+        }
+
+        for (int cpu = 0; cpu < ncpus; cpu++) {
+            ex.cpuid = cpu;
+            ex.is_excl = true;
+            tx.set_address(cpu == 0 ? 8 : cpu * 8);
+            tx.set_write();
+            if (mon.update(tx))
+                succeeded++;
+        }
+    }
+
+    double t1 = mwr::timestamp();
+    tx.clear_extension(&ex);
+
+    if (succeeded != (size_t)rounds * (ncpus - 2))
+        std::cerr << "unexpected exclusive results" << std::endl;
+
+    return (t1 - t0) * 1e9 / (2.0 * rounds * ncpus);
+}
+
+extern "C" int sc_main(int argc, char** argv) {
+    for (int ncpus : { 4, 16, 64 }) {
+        std::cout << "exmon with " << ncpus << " cpus: "
+                  << exclusive_ns(ncpus, 10000) << "ns per exclusive access"
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#include "vcml.h"
+
+// burns host time proportional to the simulated cycles while busy
+class compute_processor : public vcml::processor
+{
+public:
+    vcml::u64 cycles;
+    bool busy;
+
+    compute_processor(const sc_core::sc_module_name& nm):
+        vcml::processor(nm, "mock"), cycles(0), busy(false) {
+        clk.stub(1 * vcml::MHz);
+        rst.stub();
+        insn.stub();
+        data.stub();
+        parallel = true;
+    }
+
+    virtual ~compute_processor() = default;
+
+    virtual vcml::u64 cycle_count() const override { return cycles; }
+
+    virtual void simulate(size_t n) override {
+        volatile vcml::u64 sink = 0;
+        for (size_t i = 0; busy && i < n * 200; i++)
+            sink = sink + i;
+        cycles += n;
+    }
+};
+
+extern "C" int sc_main(int argc, char** argv) {
+    const size_t ncpus = 16;
+    std::vector<std::unique_ptr<compute_processor>> cpus;
+    for (size_t i = 0; i < ncpus; i++) {
+        std::string name = vcml::mkstr("cpu%zu", i);
+        cpus.emplace_back(new compute_processor(name.c_str()));
+    }
+
+    sc_core::sc_time quantum(1.0, sc_core::SC_MS);
+    tlm::tlm_global_quantum::instance().set(quantum);
+    sc_core::sc_start(sc_core::SC_ZERO_TIME);
+
+    double base = 0.0;
+    for (size_t n = 1; n <= ncpus; n *= 2) {
+        for (size_t i = 0; i < ncpus; i++)
+            cpus[i]->busy = i < n;
+
+        double start = mwr::timestamp();
+        sc_core::sc_start(10 * quantum);
+        double elapsed = mwr::timestamp() - start;
+
+        // serial execution would need n times as long as a single core
+        if (n == 1)
+            base = elapsed;
+        double speedup = elapsed > 0.0 ? base * n / elapsed : 0.0;
+        std::cout << n << " cores: " << elapsed * 1000.0 << "ms, "
+                  << "speedup " << speedup << "x" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
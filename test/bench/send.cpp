@@ -0,0 +1,56 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#include "vcml.h"
+
+using namespace vcml;
+
+// measures the cost of a full non-DMI transaction round-trip
+class send_bench : public component
+{
+public:
+    generic::memory ram;
+    tlm_initiator_socket out;
+
+    send_bench(const sc_module_name& nm):
+        component(nm), ram("ram", 4 * KiB), out("out") {
+        out.bind(ram.in);
+        ram.rst.stub();
+        ram.clk.stub(10 * MHz);
+        rst.stub();
+        clk.stub(10 * MHz);
+        SC_HAS_PROCESS(send_bench);
+        SC_THREAD(run);
+    }
+
+    void run() {
+        const size_t count = 1000000;
+        tlm_generic_payload tx;
+        u32 val = 0;
+
+        double t0 = mwr::timestamp();
+        for (size_t i = 0; i < count; i++) {
+            tx_setup(tx, TLM_READ_COMMAND, (i * 4) % (4 * KiB), &val, 4);
+            out.send(tx, SBI_NODMI);
+        }
+
+        double t1 = mwr::timestamp();
+        std::cout << "send: " << (t1 - t0) * 1e9 / count
+                  << "ns per transaction" << std::endl;
+        sc_stop();
+    }
+};
+
+extern "C" int sc_main(int argc, char** argv) {
+    send_bench bench("bench");
+    sc_start();
+    return EXIT_SUCCESS;
+}
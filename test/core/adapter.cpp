@@ -75,6 +75,20 @@ public:
         data = 0;
         EXPECT_OK(test3_out32.readw(0x1234, data));
         EXPECT_EQ(data, ~0ull);
+
+        // repeated accesses must not allocate any new payloads
+        tlm_mm& mm = tlm_mm::instance();
+        size_t allocs = mm.allocations();
+        size_t in_use = mm.in_use();
+        for (int i = 0; i < 100; i++) {
+            EXPECT_OK(test1_out32.readw(0x1234, data));
+            EXPECT_OK(test2_out32.readw(0x1234, data, SBI_DEBUG));
+            EXPECT_OK(test3_out32.readw(0x1234, data));
+            EXPECT_EQ(test1_out32.lookup_dmi_ptr(0x1234, 8), nullptr);
+        }
+
+        EXPECT_EQ(mm.allocations(), allocs);
+        EXPECT_EQ(mm.in_use(), in_use);
     }
 };
 
@@ -82,3 +96,33 @@ TEST(adapter, test) {
     test_harness test("harness");
     sc_core::sc_start();
 }
+
+TEST(adapter, mm) {
+    tlm_mm mm;
+    tlm_generic_payload* tx = mm.allocate();
+    ASSERT_NE(tx, nullptr);
+    ASSERT_TRUE(tx_has_sbi(*tx));
+    EXPECT_EQ(tx->get_ref_count(), 1);
+    EXPECT_EQ(mm.allocations(), 1u);
+    EXPECT_EQ(mm.in_use(), 1u);
+
+    tx_set_sbi(*tx, SBI_DEBUG | sbi_cpuid(3));
+    tx->set_address(0x1234);
+    tx->release();
+    EXPECT_EQ(mm.in_use(), 0u);
+    EXPECT_EQ(mm.pooled(), 1u);
+
+    {
+        tlm_pooled_payload ptx(mm);
+        EXPECT_EQ(&*ptx, tx);
+        EXPECT_EQ(ptx->get_address(), 0u);
+        EXPECT_FALSE(tx_is_debug(*ptx));
+        EXPECT_EQ(tx_cpuid(*ptx), SBI_NONE.cpuid);
+        EXPECT_EQ(mm.reuses(), 1u);
+        EXPECT_EQ(mm.in_use(), 1u);
+    }
+
+    EXPECT_EQ(mm.allocations(), 1u);
+    EXPECT_EQ(mm.in_use(), 0u);
+    EXPECT_EQ(mm.pooled(), 1u);
+}
@@ -36,6 +36,20 @@ public:
         });
     }
 
+    // every sc_sync must complete regardless of whether the async thread
+    // spins or sleeps while waiting for the kernel
+    void handoff(size_t spin_limit) {
+        const size_t n = 200;
+        size_t count = 0;
+        set_async_spin_limit(spin_limit);
+        sc_async([&]() -> void {
+            for (size_t i = 0; i < n; i++)
+                sc_sync([&]() -> void { count++; });
+        });
+
+        EXPECT_EQ(count, n);
+    }
+
     virtual void run_test() override {
         EXPECT_FALSE(success);
         EXPECT_TRUE(thctl_is_sysc_thread());
@@ -47,6 +61,12 @@ public:
 
         EXPECT_TRUE(success);
         EXPECT_EQ(sc_time_stamp(), 2 * dura);
+
+        size_t limit = async_spin_limit();
+        handoff(SIZE_MAX);
+        handoff(0);
+        set_async_spin_limit(limit);
+        EXPECT_EQ(sc_time_stamp(), 2 * dura);
     }
 };
 
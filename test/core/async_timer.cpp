@@ -56,6 +56,28 @@ public:
             wait(1, SC_US);
 
         async.join();
+
+        // spread timers across several wheel levels and cancel every other
+        vector<unique_ptr<async_timer>> timers;
+        size_t fired = 0;
+        auto count = [&](async_timer& t) -> void {
+            EXPECT_EQ(sc_time_stamp(), t.timeout());
+            fired++;
+        };
+
+        for (size_t i = 0; i < 200; i++) {
+            sc_time delta((double)((i * i * 7919) % 4000 + 1), SC_US);
+            timers.emplace_back(new async_timer(delta, count));
+        }
+
+        for (size_t i = 1; i < timers.size(); i += 2)
+            timers[i]->cancel();
+
+        wait(5, SC_MS);
+
+        EXPECT_EQ(fired, timers.size() / 2);
+        for (size_t i = 0; i < timers.size(); i++)
+            EXPECT_EQ(timers[i]->count(), i % 2 ? 0u : 1u) << "timer " << i;
     }
 };
 
@@ -0,0 +1,187 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "testing.h"
+
+class mock_peripheral : public peripheral
+{
+public:
+    property<u64> counter;
+    property<string> label;
+    reg<u32> ctrl;
+    reg<u32, 4> data;
+
+    mock_peripheral(const sc_module_name& nm):
+        peripheral(nm),
+        counter("counter", 0),
+        label("label", "none"),
+        ctrl("ctrl", 0x0, 0),
+        data("data", 0x4, 0) {
+        counter.set_checkpointed();
+        ctrl.set_banked();
+        clk.stub(100 * MHz);
+        rst.stub();
+    }
+
+    virtual ~mock_peripheral() = default;
+};
+
+class mock_cpu : public processor
+{
+public:
+    u64 pc;
+
+    mock_cpu(const sc_module_name& nm): processor(nm, "mock"), pc(0) {
+        clk.stub(100 * MHz);
+        rst.stub();
+        insn.stub();
+        data.stub();
+        define_cpureg_rw(0, "pc", sizeof(pc));
+    }
+
+    virtual ~mock_cpu() = default;
+
+    virtual u64 cycle_count() const override { return 0; }
+    virtual void simulate(size_t cycles) override {}
+
+    virtual bool read_reg_dbg(size_t regno, void* buf, size_t len) override {
+        memcpy(buf, &pc, min(len, sizeof(pc)));
+        return true;
+    }
+
+    virtual bool write_reg_dbg(size_t regno, const void* buf,
+                               size_t len) override {
+        memcpy(&pc, buf, min(len, sizeof(pc)));
+        return true;
+    }
+};
+
+TEST(checkpoint, roundtrip) {
+    mock_peripheral mock("mock");
+    mock_cpu cpu("cpu");
+    vcml::broker broker("test");
+    broker.define("smem.sparse", true);
+
+    generic::memory mem("mem", 64 * KiB);
+    generic::memory smem("smem", 1 * GiB);
+    block::disk disk("disk", "ramdisk:1MiB");
+    mem.in.stub();
+    mem.clk.stub(100 * MHz);
+    mem.rst.stub();
+    smem.in.stub();
+    smem.clk.stub(100 * MHz);
+    smem.rst.stub();
+
+    const u64 pgsz = tlm_sparse_memory::PAGE_SIZE;
+    u32 word = 0x66;
+
+    u8 sector[16];
+    memset(sector, 0xab, sizeof(sector));
+
+    mock.counter = 42;
+    mock.label = "hello";
+    mock.ctrl = 0x11;
+    mock.ctrl.bank(2) = 0x22;
+    mock.data[3] = 0x33;
+    cpu.pc = 0x1234;
+    mem[0] = 0x44;
+    mem[64 * KiB - 1] = 0x55;
+    EXPECT_OK(smem.write({ pgsz, pgsz + 3 }, &word, SBI_DEBUG));
+    EXPECT_TRUE(disk.seek(4 * KiB - 8));
+    EXPECT_TRUE(disk.write(sector, sizeof(sector)));
+    EXPECT_EQ(disk.num_dirty_blocks(), 2);
+
+    checkpoint saved(false);
+    saved.write("test.ckpt");
+    EXPECT_TRUE(saved.has_section("mock"));
+    EXPECT_TRUE(saved.has_section("mem"));
+    EXPECT_TRUE(saved.has_section("disk"));
+
+    mock.counter = 0;
+    mock.label = "changed";
+    mock.ctrl = 0;
+    mock.ctrl.bank(2) = 0;
+    mock.data[3] = 0;
+    cpu.pc = 0;
+    mem[0] = 0;
+    mem[64 * KiB - 1] = 0;
+    word = 0x77;
+    EXPECT_OK(smem.write({ pgsz, pgsz + 3 }, &word, SBI_DEBUG));
+    EXPECT_OK(smem.write({ 3 * pgsz, 3 * pgsz + 3 }, &word, SBI_DEBUG));
+    EXPECT_TRUE(disk.seek(0));
+    EXPECT_TRUE(disk.wzero(8 * KiB));
+    EXPECT_TRUE(disk.seek(40 * KiB));
+    EXPECT_TRUE(disk.write(sector, sizeof(sector)));
+    EXPECT_EQ(disk.num_dirty_blocks(), 3);
+
+    checkpoint restored(true);
+    restored.read("test.ckpt");
+    EXPECT_EQ(restored.num_sections(), saved.num_sections());
+    EXPECT_EQ(restored.time(), saved.time());
+    restored.apply();
+
+    EXPECT_EQ(mock.counter, 42);
+    EXPECT_EQ(mock.label.get(), "changed");
+    EXPECT_EQ(mock.ctrl, 0x11);
+    EXPECT_EQ(mock.ctrl.bank(2), 0x22);
+    EXPECT_EQ(mock.data[3], 0x33);
+    EXPECT_EQ(cpu.pc, 0x1234);
+    EXPECT_EQ(mem[0], 0x44);
+    EXPECT_EQ(mem[64 * KiB - 1], 0x55);
+
+    // sparse pages populated after the checkpoint must read zero again
+    EXPECT_OK(smem.read({ pgsz, pgsz + 3 }, &word, SBI_DEBUG));
+    EXPECT_EQ(word, 0x66);
+    EXPECT_OK(smem.read({ 3 * pgsz, 3 * pgsz + 3 }, &word, SBI_DEBUG));
+    EXPECT_EQ(word, 0);
+
+    u8 buffer[16] = {};
+    EXPECT_EQ(disk.pos(), 4 * KiB + 8);
+    EXPECT_TRUE(disk.seek(4 * KiB - 8));
+    EXPECT_TRUE(disk.read(buffer, sizeof(buffer)));
+    EXPECT_EQ(memcmp(buffer, sector, sizeof(sector)), 0);
+
+    // blocks written after the checkpoint must be reverted
+    u8 zero[16] = {};
+    EXPECT_EQ(disk.num_dirty_blocks(), 2);
+    EXPECT_TRUE(disk.seek(40 * KiB));
+    EXPECT_TRUE(disk.read(buffer, sizeof(buffer)));
+    EXPECT_EQ(memcmp(buffer, zero, sizeof(zero)), 0);
+
+    std::remove("test.ckpt");
+}
+
+TEST(checkpoint, errors) {
+    checkpoint cp(true);
+    EXPECT_THROW(cp.read("nonexistent.ckpt"), vcml::report);
+
+    std::ofstream os("invalid.ckpt");
+    os << "not a checkpoint file";
+    os.close();
+
+    EXPECT_THROW(cp.read("invalid.ckpt"), vcml::report);
+    std::remove("invalid.ckpt");
+
+    // section sizes beyond the end of the file must not be allocated
+    u32 version = checkpoint::VERSION;
+    u64 header[] = { 0, 1, 4 };
+    u64 size = 1ull << 40;
+    std::ofstream ts("truncated.ckpt", std::ios::binary);
+    ts.write(checkpoint::MAGIC, strlen(checkpoint::MAGIC));
+    ts.write((const char*)&version, sizeof(version));
+    ts.write((const char*)header, sizeof(header));
+    ts.write("mock", 4);
+    ts.write((const char*)&size, sizeof(size));
+    ts.close();
+
+    checkpoint truncated(true);
+    EXPECT_THROW(truncated.read("truncated.ckpt"), vcml::report);
+    std::remove("truncated.ckpt");
+}
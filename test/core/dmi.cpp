@@ -40,10 +40,10 @@ TEST(dmi, insert) {
     dmi.set_dmi_ptr(dummy + dmi.get_start_address());
     cache.insert(dmi);
     EXPECT_EQ(cache.get_entries().size(), 2);
-    EXPECT_EQ(cache.get_entries()[1].get_start_address(), 0);
-    EXPECT_EQ(cache.get_entries()[1].get_end_address(), 1100);
-    EXPECT_EQ(cache.get_entries()[0].get_start_address(), 1200);
-    EXPECT_EQ(cache.get_entries()[0].get_end_address(), 1500);
+    EXPECT_EQ(cache.get_entries()[0].get_start_address(), 0);
+    EXPECT_EQ(cache.get_entries()[0].get_end_address(), 1100);
+    EXPECT_EQ(cache.get_entries()[1].get_start_address(), 1200);
+    EXPECT_EQ(cache.get_entries()[1].get_end_address(), 1500);
 
     dmi.set_start_address(1000);
     dmi.set_end_address(1200);
@@ -84,10 +84,10 @@ TEST(dmi, invalidate) {
 
     cache.invalidate(400, 500);
     EXPECT_EQ(cache.get_entries().size(), 2);
-    EXPECT_EQ(cache.get_entries()[1].get_start_address(), 100);
-    EXPECT_EQ(cache.get_entries()[1].get_end_address(), 399);
-    EXPECT_EQ(cache.get_entries()[0].get_start_address(), 501);
-    EXPECT_EQ(cache.get_entries()[0].get_end_address(), 899);
+    EXPECT_EQ(cache.get_entries()[0].get_start_address(), 100);
+    EXPECT_EQ(cache.get_entries()[0].get_end_address(), 399);
+    EXPECT_EQ(cache.get_entries()[1].get_start_address(), 501);
+    EXPECT_EQ(cache.get_entries()[1].get_end_address(), 899);
 }
 
 TEST(dmi, lookup) {
@@ -108,3 +108,131 @@ TEST(dmi, lookup) {
     EXPECT_EQ(vcml::dmi_get_ptr(dmi2, 997), dummy + 997);
     EXPECT_FALSE(cache.lookup(998, 4, tlm::TLM_READ_COMMAND, dmi2));
 }
+
+TEST(dmi, lookup_invalidated) {
+    unsigned char dummy[4096];
+    vcml::tlm_dmi_cache cache;
+    tlm::tlm_dmi dmi, dmi2;
+
+    dmi.allow_read_write();
+    dmi.set_start_address(0);
+    dmi.set_end_address(4095);
+    dmi.set_dmi_ptr(dummy);
+    cache.insert(dmi);
+
+    EXPECT_TRUE(cache.lookup(100, 4, tlm::TLM_WRITE_COMMAND, dmi2));
+    EXPECT_TRUE(cache.lookup(100, 4, tlm::TLM_WRITE_COMMAND, dmi2));
+    cache.invalidate(0, 199);
+    EXPECT_FALSE(cache.lookup(100, 4, tlm::TLM_WRITE_COMMAND, dmi2));
+    EXPECT_TRUE(cache.lookup(200, 4, tlm::TLM_WRITE_COMMAND, dmi2));
+    EXPECT_EQ(vcml::dmi_get_ptr(dmi2, 200), dummy + 200);
+}
+
+TEST(dmi, overlapping) {
+    unsigned char dummy[4096];
+    vcml::tlm_dmi_cache cache;
+    tlm::tlm_dmi dmi, dmi2;
+
+    dmi.allow_read();
+    dmi.set_start_address(0);
+    dmi.set_end_address(4095);
+    dmi.set_dmi_ptr(dummy);
+    cache.insert(dmi);
+
+    dmi.allow_read_write();
+    dmi.set_start_address(1000);
+    dmi.set_end_address(1999);
+    dmi.set_dmi_ptr(dummy + 1000);
+    cache.insert(dmi);
+
+    dmi.allow_read_write();
+    dmi.set_start_address(1200);
+    dmi.set_end_address(1299);
+    dmi.set_dmi_ptr(dummy + 2000);
+    cache.insert(dmi);
+
+    EXPECT_EQ(cache.get_entries().size(), 3);
+    EXPECT_TRUE(cache.lookup(3000, 4, tlm::TLM_READ_COMMAND, dmi2));
+    EXPECT_EQ(dmi2.get_start_address(), 0);
+    EXPECT_FALSE(cache.lookup(3000, 4, tlm::TLM_WRITE_COMMAND, dmi2));
+    EXPECT_TRUE(cache.lookup(1500, 4, tlm::TLM_WRITE_COMMAND, dmi2));
+    EXPECT_EQ(dmi2.get_start_address(), 1000);
+    EXPECT_TRUE(cache.lookup(1250, 4, tlm::TLM_WRITE_COMMAND, dmi2));
+    EXPECT_EQ(vcml::dmi_get_ptr(dmi2, 1250), dummy + 2050);
+}
+
+TEST(dmi, limit) {
+    unsigned char dummy[4096];
+    vcml::tlm_dmi_cache cache;
+    tlm::tlm_dmi dmi, dmi2;
+
+    cache.set_entry_limit(4);
+    for (unsigned int i = 0; i < 8; i++) {
+        dmi.allow_read_write();
+        dmi.set_start_address(i * 0x1000);
+        dmi.set_end_address(i * 0x1000 + 0x7ff);
+        dmi.set_dmi_ptr(dummy);
+        cache.insert(dmi);
+    }
+
+    ASSERT_EQ(cache.get_entries().size(), 4);
+    EXPECT_EQ(cache.get_entries()[0].get_start_address(), 0x4000);
+    EXPECT_FALSE(cache.lookup(0x0000, 4, tlm::TLM_READ_COMMAND, dmi2));
+    EXPECT_TRUE(cache.lookup(0x7000, 4, tlm::TLM_READ_COMMAND, dmi2));
+}
+
+TEST(dmi, threads) {
+    unsigned char dummy[4096];
+    vcml::tlm_dmi_cache cache;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&]() -> void {
+        while (!done) {
+            tlm::tlm_dmi dmi;
+            dmi.allow_read_write();
+            dmi.set_start_address(0);
+            dmi.set_end_address(4095);
+            dmi.set_dmi_ptr(dummy);
+            cache.insert(dmi);
+            cache.invalidate(100, 199);
+        }
+    });
+
+    tlm::tlm_dmi dmi;
+    for (int i = 0; i < 100000; i++) {
+        if (cache.lookup(8, 4, tlm::TLM_READ_COMMAND, dmi))
+            EXPECT_EQ(vcml::dmi_get_ptr(dmi, 8), dummy + 8);
+    }
+
+    done = true;
+    writer.join();
+}
+
+TEST(dmi, many) {
+    static unsigned char dummy[4096];
+    const size_t entries = 256;
+
+    vcml::tlm_dmi_cache cache;
+    cache.set_entry_limit(entries);
+    for (size_t i = 0; i < entries; i++) {
+        tlm::tlm_dmi dmi;
+        dmi.allow_read_write();
+        dmi.set_start_address(i * 0x2000);
+        dmi.set_end_address(i * 0x2000 + 0xfff);
+        dmi.set_dmi_ptr(dummy);
+        cache.insert(dmi);
+        cache.insert(dmi);
+    }
+
+    EXPECT_EQ(cache.get_entries().size(), entries);
+
+    tlm::tlm_dmi dmi;
+    for (size_t i = 0; i < entries; i++) {
+        size_t idx = (i * 7919) % entries;
+        EXPECT_TRUE(cache.lookup(idx * 0x2000 + 8, 4, tlm::TLM_READ_COMMAND,
+                                 dmi));
+        EXPECT_EQ(dmi.get_start_address(), idx * 0x2000);
+        EXPECT_FALSE(cache.lookup(idx * 0x2000 + 0x1000, 4,
+                                  tlm::TLM_READ_COMMAND, dmi));
+    }
+}
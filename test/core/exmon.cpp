@@ -114,3 +114,72 @@ TEST(tlm_exmon, dmi) {
     EXPECT_EQ(dmi.get_end_address(), -1);
     EXPECT_EQ(dmi.get_dmi_ptr(), (unsigned char*)400);
 }
+
+TEST(tlm_exmon, granules) {
+    vcml::tlm_exmon mon;
+    EXPECT_FALSE(mon.has_locks());
+
+    mon.add_lock(0, { 0x40, 0x43 });
+    mon.add_lock(1, { 0x7e, 0x81 });  // spans two granules
+    mon.add_lock(2, { 0x0, 0xffff }); // too wide for granule indexing
+    EXPECT_TRUE(mon.has_locks());
+    EXPECT_TRUE(mon.has_lock(1, { 0x7e, 0x81 }));
+    EXPECT_FALSE(mon.has_lock(1, { 0x40, 0x43 }));
+    EXPECT_FALSE(mon.has_lock(3, { 0x40, 0x43 }));
+
+    mon.add_lock(1, { 0x100, 0x107 }); // replaces previous lock of cpu 1
+    EXPECT_EQ(mon.get_locks().size(), 3);
+    EXPECT_FALSE(mon.has_lock(1, { 0x7e, 0x81 }));
+
+    mon.break_locks({ 0x44, 0x47 }); // same granule, but no overlap
+    EXPECT_TRUE(mon.has_lock(0, { 0x40, 0x43 }));
+    EXPECT_FALSE(mon.has_lock(2, { 0x0, 0xffff }));
+    EXPECT_EQ(mon.get_locks().size(), 2);
+
+    mon.break_locks({ 0x42, 0x42 });
+    EXPECT_FALSE(mon.has_lock(0, { 0x40, 0x43 }));
+    EXPECT_TRUE(mon.has_lock(1, { 0x100, 0x107 }));
+
+    mon.break_locks(1);
+    EXPECT_FALSE(mon.has_locks());
+}
+
+TEST(tlm_exmon, contention) {
+    const int ncpus = 64;
+    const int rounds = 100;
+
+    vcml::tlm_exmon mon;
+    vcml::sbiext ex;
+    tlm::tlm_generic_payload tx;
+    vcml::u32 data = 0;
+    tx.set_data_ptr((unsigned char*)&data);
+    tx.set_data_length(sizeof(data));
+    tx.set_streaming_width(sizeof(data));
+    tx.set_extension(&ex);
+
+    // all cpus spin on their own lock word, cpu 0 also competes for cpu 1
+    size_t succeeded = 0;
+    for (int i = 0; i < rounds; i++) {
+        for (int cpu = 0; cpu < ncpus; cpu++) {
+            ex.cpuid = cpu;
+            ex.is_excl = true;
+            tx.set_address(cpu * 8);
+            tx.set_read();
+            EXPECT_TRUE(mon.update(tx));
+        }
+
+        for (int cpu = 0; cpu < ncpus; cpu++) {
+            ex.cpuid = cpu;
+            ex.is_excl = true;
+            tx.set_address(cpu == 0 ? 8 : cpu * 8);
+            tx.set_write();
+            if (mon.update(tx))
+                succeeded++;
+        }
+    }
+
+    EXPECT_EQ(succeeded, (size_t)rounds * (ncpus - 2));
+    EXPECT_EQ(mon.get_locks().size(), 1);
+    EXPECT_TRUE(mon.has_lock(0, { 0, 3 }));
+    tx.clear_extension(&ex);
+}
@@ -0,0 +1,74 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+#include "vcml.h"
+
+// executes a single quantum after each interrupt and then waits for the next
+class idle_processor : public vcml::processor
+{
+public:
+    vcml::u64 cycles;
+
+    idle_processor(const sc_core::sc_module_name& nm):
+        vcml::processor(nm, "mock"), cycles(0) {
+        clk.stub(1 * vcml::MHz);
+        rst.stub();
+        insn.stub();
+        data.stub();
+        idle_skip = true;
+    }
+
+    virtual ~idle_processor() = default;
+
+    virtual vcml::u64 cycle_count() const override { return cycles; }
+
+    virtual void simulate(size_t n) override {
+        cycles += n;
+        set_idle();
+    }
+};
+
+TEST(idle, skip) {
+    idle_processor cpu("cpu");
+    vcml::gpio_initiator_socket irq("irq");
+    vcml::gpio_initiator_socket lvl("lvl");
+    irq.bind(cpu.irq[0]);
+    lvl.bind(cpu.irq[1]);
+
+    sc_core::sc_time quantum(100, sc_core::SC_US);
+    tlm::tlm_global_quantum::instance().set(quantum);
+
+    auto tick = [&](vcml::async_timer& t) -> void {
+        irq.pulse();
+        t.reset(1, sc_core::SC_SEC);
+    };
+
+    vcml::async_timer timer(1, sc_core::SC_SEC, tick);
+
+    sc_core::sc_start(10, sc_core::SC_SEC);
+
+    // one quantum at startup and one after each interrupt
+    EXPECT_TRUE(cpu.is_idle());
+    EXPECT_LE(cpu.cycles, 11 * quantum / cpu.clock_cycle());
+    EXPECT_GE(cpu.get_idle_skips(), 9u);
+    EXPECT_GT(cpu.get_idle_time(), sc_core::sc_time(9, sc_core::SC_SEC));
+    EXPECT_EQ(sc_core::sc_time_stamp(), sc_core::sc_time(10, sc_core::SC_SEC));
+
+    // a pending interrupt level keeps the processor from going to sleep
+    vcml::u64 cycles = cpu.cycles;
+    lvl.raise();
+    sc_core::sc_start(500, sc_core::SC_MS);
+    EXPECT_GE(cpu.cycles - cycles,
+              sc_core::sc_time(400, sc_core::SC_MS) / cpu.clock_cycle());
+}
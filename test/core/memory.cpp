@@ -56,6 +56,215 @@ TEST(alignment, input) {
     EXPECT_EQ(a, VCML_ALIGN_1K);
 }
 
+TEST(memory, placement) {
+    tlm_memory mem;
+    mem.init("", 64 * KiB, VCML_ALIGN_NONE, true);
+    mem.use_hugepages();
+    mem.bind_numa(0);
+    EXPECT_TRUE(mem.prefault());
+    EXPECT_TRUE(mem.is_prefaulted());
+
+    // memory must remain usable even if the host refused all hints
+    EXPECT_EQ(mem.size(), 64 * KiB);
+    mem[0] = 0x42;
+    mem[64 * KiB - 1] = 0x24;
+    EXPECT_EQ(mem[0], 0x42);
+    EXPECT_EQ(mem[64 * KiB - 1], 0x24);
+
+    mem.free();
+    EXPECT_FALSE(mem.has_hugetlb());
+    EXPECT_FALSE(mem.is_prefaulted());
+    EXPECT_EQ(mem.numa_node(), -1);
+}
+
+TEST(memory, snapshot) {
+    tlm_memory mem(3 * 4096 + 100, VCML_ALIGN_64K);
+    u8* ptr = mem.data();
+
+    mem[0] = 0x11;
+    mem[3 * 4096 + 50] = 0x22;
+    EXPECT_FALSE(mem.has_snapshot("boot"));
+    EXPECT_TRUE(mem.snapshot("boot"));
+    EXPECT_TRUE(mem.has_snapshot("boot"));
+    EXPECT_EQ(mem.data(), ptr);
+    EXPECT_EQ(mem[0], 0x11);
+    EXPECT_EQ(mem[3 * 4096 + 50], 0x22);
+
+    mem[0] = 0x33;
+    mem[4096] = 0x44;
+    EXPECT_TRUE(mem.snapshot("run"));
+    EXPECT_TRUE(mem.restore("boot"));
+    EXPECT_EQ(mem.data(), ptr);
+    EXPECT_EQ(mem[0], 0x11);
+    EXPECT_EQ(mem[4096], 0x00);
+    EXPECT_EQ(mem[3 * 4096 + 50], 0x22);
+
+    mem[0] = 0x55;
+    EXPECT_TRUE(mem.restore("run"));
+    EXPECT_EQ(mem[0], 0x33);
+    EXPECT_EQ(mem[4096], 0x44);
+
+    EXPECT_EQ(mem.snapshots(), std::vector<std::string>({ "boot", "run" }));
+    mem.drop_snapshot("boot");
+    EXPECT_FALSE(mem.restore("boot"));
+    EXPECT_EQ(mem[0], 0x33);
+}
+
+TEST(memory, map_file) {
+    vector<u8> image(2 * 4096 + 10);
+    for (size_t i = 0; i < image.size(); i++)
+        image[i] = (u8)(i * 7 + 1);
+
+    std::ofstream of("map.bin", std::ios::binary | std::ios::out);
+    of.write((const char*)image.data(), image.size());
+    of.close();
+
+    tlm_memory mem(64 * KiB);
+    mem.fill(0xff);
+
+    EXPECT_FALSE(mem.map_file("map.bin", 100));
+    EXPECT_FALSE(mem.map_file("map.bin", 60 * KiB));
+    EXPECT_FALSE(mem.map_file("nonexistent.bin", 0));
+    EXPECT_TRUE(mem.map_file("map.bin", 4096));
+
+    EXPECT_EQ(mem[4095], 0xff);
+    EXPECT_EQ(memcmp(mem.data() + 4096, image.data(), image.size()), 0);
+    EXPECT_EQ(mem[4096 + image.size()], 0xff);
+
+    // writes must not reach the file
+    mem[4096] = ~image[0];
+    EXPECT_TRUE(mem.map_file("map.bin", 4096));
+    EXPECT_EQ(mem[4096], image[0]);
+
+    std::remove("map.bin");
+}
+
+TEST(memory, dirty) {
+    tlm_memory mem(5 * 4096 + 16);
+    u32 val = 0x12345678;
+
+    EXPECT_OK(mem.write(0x10, val));
+    EXPECT_TRUE(mem.fetch_dirty().empty());
+    EXPECT_FALSE(mem.is_dirty({ 0x10, 0x13 }));
+
+    mem.track_dirty();
+    EXPECT_TRUE(mem.is_tracking_dirty());
+    EXPECT_TRUE(mem.fetch_dirty().empty());
+
+    EXPECT_OK(mem.write(0x1ffe, val));
+    EXPECT_OK(mem.write(0x4000, val));
+    EXPECT_OK(mem.read(0x3000, val));
+    EXPECT_TRUE(mem.is_dirty({ 0x1000, 0x1fff }));
+    EXPECT_FALSE(mem.is_dirty({ 0x3000, 0x3fff }));
+
+    vector<range> dirty = mem.fetch_dirty(false);
+    ASSERT_EQ(dirty.size(), 2);
+    EXPECT_EQ(dirty[0], range(0x1000, 0x2fff));
+    EXPECT_EQ(dirty[1], range(0x4000, 0x4fff));
+    EXPECT_EQ(mem.fetch_dirty(), dirty);
+    EXPECT_TRUE(mem.fetch_dirty().empty());
+
+    mem.fill(0xff);
+    dirty = mem.fetch_dirty();
+    ASSERT_EQ(dirty.size(), 1);
+    EXPECT_EQ(dirty[0], range(0, mem.size() - 1));
+
+    mem.track_dirty(false);
+    EXPECT_OK(mem.write(0x10, val));
+    EXPECT_TRUE(mem.fetch_dirty().empty());
+}
+
+TEST(memory, sparse) {
+    const u64 size = 256ull * GiB;
+    const u64 pgsz = tlm_sparse_memory::PAGE_SIZE;
+    tlm_sparse_memory mem(size);
+    EXPECT_EQ(mem.size(), size);
+    EXPECT_EQ(mem.levels(), 2);
+    EXPECT_EQ(mem.resident_pages(), 0);
+
+    u64 val = ~0ull;
+    EXPECT_OK(mem.read({ size - 8, size - 1 }, &val));
+    EXPECT_EQ(val, 0);
+    EXPECT_EQ(mem.lookup(size - 8), nullptr);
+    EXPECT_EQ(mem.resident_pages(), 0);
+
+    // writing zeros to untouched memory must not allocate pages
+    EXPECT_OK(mem.write({ 0x1000, 0x1007 }, &val));
+    EXPECT_EQ(mem.resident_pages(), 0);
+
+    val = 0x1122334455667788ull;
+    EXPECT_OK(mem.write({ size - 8, size - 1 }, &val));
+    EXPECT_EQ(mem.resident_pages(), 1);
+    EXPECT_NE(mem.lookup(size - 8), nullptr);
+
+    // write crossing a page boundary populates both pages
+    EXPECT_OK(mem.write({ pgsz - 4, pgsz + 3 }, &val));
+    EXPECT_EQ(mem.resident_pages(), 3);
+    EXPECT_EQ(mem.resident_bytes(), 3 * pgsz);
+
+    u64 back = 0;
+    EXPECT_OK(mem.read({ pgsz - 4, pgsz + 3 }, &back));
+    EXPECT_EQ(back, val);
+
+    vector<u64> pages = { 0, pgsz, size - pgsz };
+    EXPECT_EQ(mem.resident(), pages);
+
+    tlm_dmi dmi;
+    EXPECT_FALSE(mem.get_dmi(2 * pgsz, dmi));
+    EXPECT_TRUE(mem.get_dmi(pgsz + 0x10, dmi));
+    EXPECT_EQ(dmi.get_start_address(), pgsz);
+    EXPECT_EQ(dmi.get_end_address(), 2 * pgsz - 1);
+    EXPECT_EQ(dmi.get_dmi_ptr(), mem.lookup(pgsz));
+    EXPECT_TRUE(dmi.is_read_write_allowed());
+
+    mem.allow_read_only();
+    EXPECT_EQ(mem.write({ 0, 7 }, &val), TLM_COMMAND_ERROR_RESPONSE);
+    EXPECT_OK(mem.write({ 0, 7 }, &val, true));
+    EXPECT_TRUE(mem.get_dmi(0, dmi));
+    EXPECT_FALSE(dmi.is_write_allowed());
+
+    EXPECT_EQ(mem.write({ size, size + 7 }, &val, true),
+              TLM_ADDRESS_ERROR_RESPONSE);
+
+    mem.clear();
+    EXPECT_EQ(mem.resident_pages(), 0);
+    EXPECT_EQ(mem.resident_tables(), 0);
+    EXPECT_OK(mem.read({ pgsz - 4, pgsz + 3 }, &back));
+    EXPECT_EQ(back, 0);
+}
+
+static void write_image(const string& path, size_t size, u8 seed) {
+    std::ofstream of(path, std::ios::binary | std::ios::out);
+    for (size_t i = 0; i < size; i++)
+        of.put((char)(i * seed));
+}
+
+TEST(memory, map_file_shared) {
+    write_image("rom_a.bin", 3 * 4096, 3);
+    write_image("rom_b.bin", 3 * 4096, 3);
+    write_image("rom_c.bin", 3 * 4096, 5);
+
+    size_t cached = tlm_memory::cached_images();
+    tlm_memory mem_a(16 * KiB), mem_b(16 * KiB), mem_c(16 * KiB);
+    EXPECT_TRUE(mem_a.map_file("rom_a.bin", 0));
+    EXPECT_TRUE(mem_b.map_file("rom_b.bin", 0));
+    EXPECT_TRUE(mem_c.map_file("rom_c.bin", 0));
+    EXPECT_TRUE(mem_b.map_file("rom_a.bin", 0));
+
+    // rom_a and rom_b have identical contents and share their pages
+    EXPECT_EQ(tlm_memory::cached_images(), cached + 2);
+    EXPECT_EQ(memcmp(mem_a.data(), mem_b.data(), 3 * 4096), 0);
+    EXPECT_NE(memcmp(mem_a.data(), mem_c.data(), 3 * 4096), 0);
+
+    // writes stay private to each memory
+    mem_a[0] = 0xee;
+    EXPECT_EQ(mem_b[0], 0);
+
+    std::remove("rom_a.bin");
+    std::remove("rom_b.bin");
+    std::remove("rom_c.bin");
+}
+
 TEST(memory, readwrite) {
     tlm_memory mem(1);
 
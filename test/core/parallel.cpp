@@ -0,0 +1,64 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+#include "vcml.h"
+
+class compute_processor : public vcml::processor
+{
+public:
+    vcml::u64 cycles;
+    sc_core::sc_time max_offset;
+
+    compute_processor(const sc_core::sc_module_name& nm):
+        vcml::processor(nm, "mock"), cycles(0), max_offset() {
+        clk.stub(1 * vcml::MHz);
+        rst.stub();
+        insn.stub();
+        data.stub();
+        parallel = true;
+    }
+
+    virtual ~compute_processor() = default;
+
+    virtual vcml::u64 cycle_count() const override { return cycles; }
+
+    virtual void simulate(size_t n) override {
+        sc_core::sc_time offset = vcml::async_time_offset();
+        if (offset > max_offset)
+            max_offset = offset;
+        cycles += n;
+    }
+};
+
+TEST(parallel, windows) {
+    const size_t ncpus = 4;
+    std::vector<std::unique_ptr<compute_processor>> cpus;
+    for (size_t i = 0; i < ncpus; i++) {
+        std::string name = vcml::mkstr("cpu%zu", i);
+        cpus.emplace_back(new compute_processor(name.c_str()));
+    }
+
+    sc_core::sc_time quantum(1.0, sc_core::SC_MS);
+    tlm::tlm_global_quantum::instance().set(quantum);
+    sc_core::sc_start(10 * quantum);
+
+    // all processors must have completed every quantum window without
+    // running ahead of the current one
+    for (auto& cpu : cpus) {
+        EXPECT_GE(cpu->cycles, 9 * 1000u) << cpu->name();
+        EXPECT_LE(cpu->max_offset, quantum) << cpu->name();
+    }
+
+    EXPECT_EQ(sc_core::sc_time_stamp(), 10 * quantum);
+}
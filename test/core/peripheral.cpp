@@ -197,6 +197,150 @@ TEST(peripheral, transporting_byte_enable) {
     EXPECT_EQ(local, cycle * mock.write_latency);
 }
 
+TEST(peripheral, transporting_byte_enable_runs) {
+    mock_peripheral mock;
+    tlm_generic_payload tx;
+    sc_core::sc_time cycle(1.0 / mock.clk, sc_core::SC_SEC);
+    sc_core::sc_time& local = mock.local_time();
+    unsigned char buf[100];
+    u8 byte_enable[4] = { 0xff, 0xff, 0x00, 0xff };
+
+    tx_setup(tx, tlm::TLM_WRITE_COMMAND, 4, buf, 8);
+    tx.set_byte_enable_length(4);
+    tx.set_byte_enable_ptr(byte_enable);
+    local = sc_core::SC_ZERO_TIME;
+
+    EXPECT_CALL(mock, read(_, _, _, _)).Times(0);
+
+    // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+    EXPECT_CALL(mock, write(range(4, 5), buf + 0, SBI_NONE, VCML_AS_DEFAULT))
+        .Times(1)
+        .WillOnce(Return(TLM_OK_RESPONSE));
+
+    // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+    EXPECT_CALL(mock, write(range(7, 9), buf + 3, SBI_NONE, VCML_AS_DEFAULT))
+        .Times(1)
+        .WillOnce(Return(TLM_OK_RESPONSE));
+
+    // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+    EXPECT_CALL(mock, write(range(11, 11), buf + 7, SBI_NONE, VCML_AS_DEFAULT))
+        .Times(1)
+        .WillOnce(Return(TLM_OK_RESPONSE));
+
+    // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+    EXPECT_EQ(mock.transport(tx, SBI_NONE, VCML_AS_DEFAULT), 6);
+    EXPECT_EQ(tx.get_response_status(), TLM_OK_RESPONSE);
+    EXPECT_EQ(tx.get_address(), 4);
+    EXPECT_EQ(tx.get_data_length(), 8);
+    EXPECT_EQ(tx.get_byte_enable_ptr(), byte_enable);
+    EXPECT_EQ(local, cycle * mock.write_latency);
+}
+
+class byte_memory : public peripheral
+{
+public:
+    u8 mem[32];
+    u64 bad_addr;
+
+    byte_memory(const sc_core::sc_module_name& nm):
+        peripheral(nm, ENDIAN_LITTLE, 1, 10), mem(), bad_addr(~0ull) {
+        clk.stub(100 * MHz);
+        handle_clock_update(0, clk.read());
+        for (size_t i = 0; i < sizeof(mem); i++)
+            mem[i] = 0xa0 + i;
+    }
+
+    virtual tlm_response_status read(const range& addr, void* data,
+                                     const tlm_sbi& info,
+                                     address_space as) override {
+        if (addr.includes(bad_addr) || addr.end >= sizeof(mem))
+            return TLM_ADDRESS_ERROR_RESPONSE;
+        memcpy(data, mem + addr.start, addr.length());
+        return TLM_OK_RESPONSE;
+    }
+
+    virtual tlm_response_status write(const range& addr, const void* data,
+                                      const tlm_sbi& info,
+                                      address_space as) override {
+        if (addr.includes(bad_addr) || addr.end >= sizeof(mem))
+            return TLM_ADDRESS_ERROR_RESPONSE;
+        memcpy(mem + addr.start, data, addr.length());
+        return TLM_OK_RESPONSE;
+    }
+};
+
+// issues one single byte transaction per enabled byte, i.e. the behavior of
+// peripheral::transport before byte enable runs were dispatched at once
+static tlm_response_status transport_bytewise(byte_memory& ref,
+                                              tlm_command cmd, u64 addr,
+                                              u8* data, unsigned int length,
+                                              unsigned int swidth,
+                                              const u8* be, size_t be_len) {
+    tlm_generic_payload tx;
+    tlm_response_status rs = TLM_INCOMPLETE_RESPONSE;
+    unsigned int be_index = 0;
+
+    for (unsigned int pulse = 0; pulse < length / swidth; pulse++) {
+        for (unsigned int byte = 0; byte < swidth; byte++) {
+            if (!be[be_index++ % be_len])
+                continue;
+
+            u8* ptr = data + pulse * swidth + byte;
+            tx_setup(tx, cmd, addr + byte, ptr, 1);
+            ref.transport(tx, SBI_NONE, VCML_AS_DEFAULT);
+            rs = tx.get_response_status();
+            if (rs != TLM_OK_RESPONSE)
+                return rs;
+        }
+    }
+
+    return rs;
+}
+
+TEST(peripheral, transporting_byte_enable_bytewise) {
+    const vector<vector<u8>> masks = {
+        { 0xff },
+        { 0x00, 0xff },
+        { 0xff, 0xff, 0x00, 0xff },
+        { 0x00, 0xff, 0xff, 0x00, 0x00, 0xff },
+        { 0xff, 0xff, 0xff, 0x00, 0xff, 0xff, 0xff, 0x00 },
+    };
+
+    for (tlm_command cmd : { tlm::TLM_READ_COMMAND, tlm::TLM_WRITE_COMMAND }) {
+        for (unsigned int swidth : { 4u, 8u }) {
+            for (u64 bad : { ~0ull, 6ull }) {
+                for (const vector<u8>& be : masks) {
+                    byte_memory dut(sc_core::sc_gen_unique_name("dut"));
+                    byte_memory ref(sc_core::sc_gen_unique_name("ref"));
+                    dut.bad_addr = ref.bad_addr = bad;
+
+                    u8 dut_data[8], ref_data[8];
+                    for (u8 i = 0; i < sizeof(dut_data); i++)
+                        dut_data[i] = ref_data[i] = 0x10 + i;
+
+                    tlm_generic_payload tx;
+                    tx_setup(tx, cmd, 4, dut_data, sizeof(dut_data));
+                    tx.set_streaming_width(swidth);
+                    tx.set_byte_enable_ptr((u8*)be.data());
+                    tx.set_byte_enable_length(be.size());
+                    dut.transport(tx, SBI_NONE, VCML_AS_DEFAULT);
+
+                    tlm_response_status rs = transport_bytewise(
+                        ref, cmd, 4, ref_data, sizeof(ref_data), swidth,
+                        be.data(), be.size());
+
+                    EXPECT_EQ(tx.get_response_status(), rs);
+                    if (rs != TLM_OK_RESPONSE)
+                        continue; // partially completed runs may differ
+
+                    EXPECT_EQ(memcmp(dut_data, ref_data, 8), 0);
+                    EXPECT_EQ(memcmp(dut.mem, ref.mem, sizeof(dut.mem)), 0);
+                }
+            }
+        }
+    }
+}
+
 TEST(peripheral, transporting_byte_enable_with_streaming) {
     mock_peripheral mock;
     tlm_generic_payload tx;
@@ -21,6 +21,7 @@ class mock_processor : public vcml::processor
 {
 public:
     vcml::u64 cycles;
+    bool mmu;
 
     vcml::gpio_initiator_socket rst_out;
     vcml::clk_initiator_socket clk_out;
@@ -37,6 +38,7 @@ public:
     mock_processor(const sc_core::sc_module_name& nm):
         vcml::processor(nm, "mock"),
         cycles(0),
+        mmu(false),
         rst_out("rst_out"),
         clk_out("clk_out"),
         irq0("irq0"),
@@ -60,6 +62,22 @@ public:
         ASSERT_EQ(local_time(), clock_cycles(n));
     }
 
+    virtual bool page_size(vcml::u64& size) override {
+        size = 4 * vcml::KiB;
+        return mmu;
+    }
+
+    // virtual pages 0 and 1 map to physical pages 1 and 2, page 2 maps to
+    // physical page 0 and everything above is unmapped
+    virtual bool virt_to_phys(vcml::u64 vaddr, vcml::u64& paddr) override {
+        vcml::u64 page = vaddr / (4 * vcml::KiB);
+        if (page > 2)
+            return false;
+        paddr = (page == 2 ? 0 : (page + 1) * 4 * vcml::KiB) +
+                vaddr % (4 * vcml::KiB);
+        return true;
+    }
+
     virtual void end_of_elaboration() override {
         clk_out = DEFCLK;
         rst_out.pulse();
@@ -68,7 +86,7 @@ public:
 
 TEST(processor, processor) {
     vcml::generic::memory imem("IMEM", 0x1000);
-    vcml::generic::memory dmem("DMEM", 0x1000);
+    vcml::generic::memory dmem("DMEM", 0x4000);
 
     mock_processor cpu("CPU");
 
@@ -151,4 +169,40 @@ TEST(processor, processor) {
     EXPECT_CALL(cpu, handle_clock_update(0, DEFCLK)).Times(1);
     cpu.clk_out = DEFCLK;
     sc_core::sc_start(10 * quantum);
+
+    // test bulk debug memory accesses across page and DMI boundaries
+    vcml::debugging::target& tgt = cpu;
+    std::vector<vcml::u8> pattern(0x3000), buffer(0x3000);
+    for (size_t i = 0; i < pattern.size(); i++)
+        pattern[i] = i * 7;
+
+    dmem.track_dirty();
+    EXPECT_EQ(tgt.write_pmem_dbg(0x800, pattern.data(), 0x3000), 0x3000);
+    EXPECT_EQ(tgt.read_pmem_dbg(0x800, buffer.data(), 0x3000), 0x3000);
+    EXPECT_EQ(buffer, pattern);
+    EXPECT_FALSE(cpu.data.dmi_cache().get_entries().empty());
+
+    // debug writes must not bypass dirty tracking of the target
+    vcml::u64 dirty = 0;
+    for (const vcml::range& r : dmem.fetch_dirty())
+        dirty += r.length();
+    EXPECT_EQ(dirty, 0x4000);
+    dmem.track_dirty(false);
+
+    auto phys = [&](vcml::u64 pa) -> vcml::u8 {
+        return pa >= 0x800 && pa < 0x3800 ? pattern[pa - 0x800] : 0;
+    };
+
+    cpu.mmu = true;
+    EXPECT_EQ(tgt.read_vmem_dbg(0, buffer.data(), 0x3000), 0x3000);
+    for (vcml::u64 va = 0; va < 0x3000; va++) {
+        vcml::u64 pa = va < 0x2000 ? va + 0x1000 : va - 0x2000;
+        ASSERT_EQ(buffer[va], phys(pa)) << "at address " << va;
+    }
+
+    EXPECT_EQ(tgt.read_vmem_dbg(0x2ff0, buffer.data(), 0x20), 0x10);
+    EXPECT_EQ(buffer[0x0f], phys(0xfff));
+    EXPECT_EQ(buffer[0x10], 0xee);
+    EXPECT_EQ(buffer[0x1f], 0xee);
+    cpu.mmu = false;
 }
@@ -366,6 +366,33 @@ TEST(registers, banking) {
     tx.clear_extension(&bank);
 }
 
+TEST(registers, bank_storage) {
+    mock_peripheral mock;
+    mock.test_reg_a.set_banked();
+    mock.test_reg_a = 0x1234;
+
+    const auto& cref = mock.test_reg_a;
+    EXPECT_EQ(cref.bank(0), 0x1234u);
+    EXPECT_EQ(cref.bank(7), 0xffffffffu); // not created yet, use default
+
+    u32& bank3 = mock.test_reg_a.bank(3);
+    EXPECT_EQ(bank3, 0xffffffffu);
+    bank3 = 0x33;
+
+    // creating higher banks must not move existing ones
+    mock.test_reg_a.bank(64) = 0x64;
+    EXPECT_EQ(&bank3, &mock.test_reg_a.bank(3));
+    EXPECT_EQ(cref.bank(3), 0x33u);
+    EXPECT_EQ(cref.bank(64), 0x64u);
+    EXPECT_EQ(cref.bank(1), 0xffffffffu);
+    EXPECT_EQ(cref.bank(0), 0x1234u);
+
+    mock.test_reg_a.reset();
+    EXPECT_EQ(cref.bank(0), 0xffffffffu);
+    EXPECT_EQ(cref.bank(3), 0xffffffffu);
+    EXPECT_EQ(cref.bank(64), 0xffffffffu);
+}
+
 TEST(registers, endianess) {
     mock_peripheral mock;
     mock.set_big_endian();
@@ -392,6 +419,46 @@ TEST(registers, endianess) {
     EXPECT_TRUE(tx.is_response_ok());
 }
 
+TEST(registers, profiling) {
+    mock_peripheral mock;
+    u32 buffer = 0;
+    tlm::tlm_generic_payload tx;
+
+    tx_setup(tx, tlm::TLM_READ_COMMAND, 0, &buffer, 4);
+    EXPECT_EQ(mock.test_transport(tx), 4);
+    EXPECT_EQ(mock.test_reg_a.get_stats().num_reads, 0);
+
+    mock.profile_registers = true;
+    for (int i = 0; i < 3; i++) {
+        tx_setup(tx, tlm::TLM_READ_COMMAND, 0, &buffer, 4);
+        EXPECT_EQ(mock.test_transport(tx), 4);
+    }
+
+    tx_setup(tx, tlm::TLM_WRITE_COMMAND, 0, &buffer, 2);
+    EXPECT_EQ(mock.test_transport(tx), 2);
+
+    const reg_stats& st = mock.test_reg_a.get_stats();
+    EXPECT_EQ(st.num_reads, 3);
+    EXPECT_EQ(st.num_writes, 1);
+    EXPECT_EQ(st.bytes_read, 12);
+    EXPECT_EQ(st.bytes_written, 2);
+    EXPECT_EQ(st.num_accesses(), 4);
+    EXPECT_EQ(mock.test_reg_b.get_stats().num_accesses(), 0);
+
+    std::stringstream ss;
+    EXPECT_TRUE(mock.execute("regstats", ss));
+    EXPECT_NE(ss.str().find("test_reg_a"), string::npos);
+    EXPECT_EQ(ss.str().find("test_reg_b"), string::npos);
+
+    std::stringstream csv;
+    peripheral::export_regstats(csv);
+    string row = mkstr("%s,test_reg_a,0,3,1,12,2,", mock.name());
+    EXPECT_NE(csv.str().find(row), string::npos);
+
+    EXPECT_TRUE(mock.execute("regstats", { "reset" }, ss));
+    EXPECT_EQ(mock.test_reg_a.get_stats().num_accesses(), 0);
+}
+
 TEST(registers, operators) {
     mock_peripheral mock;
 
@@ -502,6 +569,77 @@ TEST(registers, lambda) {
     EXPECT_EQ(data, 0x42);
 }
 
+class static_binding_test : public peripheral
+{
+public:
+    reg<u32> plain;
+    reg<u32, 2> tagged;
+
+    u32 last_write;
+    size_t last_tag;
+
+    u32 read_plain() { return 0x11223344; }
+    void write_plain(u32 val) { last_write = val; }
+
+    u32 read_tagged(size_t tag) { return 0xa0 + tag; }
+    void write_tagged(u32 val, size_t tag) {
+        last_write = val;
+        last_tag = tag;
+    }
+
+    static_binding_test(const sc_core::sc_module_name& nm):
+        peripheral(nm),
+        plain("plain", 0x0),
+        tagged("tagged", 0x4),
+        last_write(0),
+        last_tag(0) {
+        plain.on_read<&static_binding_test::read_plain>();
+        plain.on_write<&static_binding_test::write_plain>();
+        tagged.on_read<&static_binding_test::read_tagged>();
+        tagged.on_write<&static_binding_test::write_tagged>(this);
+    }
+};
+
+TEST(registers, static_binding) {
+    static_binding_test test("static_binding");
+    EXPECT_DEATH(test.plain.on_read([]() -> u32 { return 0; }),
+                 "read callback already defined");
+
+    u32 data = 0;
+    tlm::tlm_generic_payload tx;
+    tx_setup(tx, tlm::TLM_READ_COMMAND, 0x8, &data, sizeof(data));
+    test.transport(tx, SBI_NONE, VCML_AS_DEFAULT);
+    EXPECT_TRUE(tx.is_response_ok());
+    EXPECT_EQ(data, 0xa1);
+
+    data = 0x55;
+    tx_setup(tx, tlm::TLM_WRITE_COMMAND, 0x4, &data, sizeof(data));
+    test.transport(tx, SBI_NONE, VCML_AS_DEFAULT);
+    EXPECT_TRUE(tx.is_response_ok());
+    EXPECT_EQ(test.last_write, 0x55);
+    EXPECT_EQ(test.last_tag, 0);
+
+    // whole cells are swapped in the register, partial ones in the buffer
+    test.set_big_endian();
+    tx_setup(tx, tlm::TLM_READ_COMMAND, 0x0, &data, sizeof(data));
+    test.transport(tx, SBI_NONE, VCML_AS_DEFAULT);
+    EXPECT_TRUE(tx.is_response_ok());
+    EXPECT_EQ(data, 0x44332211);
+
+    u16 half = 0;
+    tx_setup(tx, tlm::TLM_READ_COMMAND, 0x0, &half, sizeof(half));
+    test.transport(tx, SBI_NONE, VCML_AS_DEFAULT);
+    EXPECT_TRUE(tx.is_response_ok());
+    EXPECT_EQ(half, 0x4433);
+
+    data = 0x11223344;
+    tx_setup(tx, tlm::TLM_WRITE_COMMAND, 0x0, &data, sizeof(data));
+    test.transport(tx, SBI_NONE, VCML_AS_DEFAULT);
+    EXPECT_TRUE(tx.is_response_ok());
+    EXPECT_EQ(test.last_write, 0x44332211);
+    EXPECT_EQ(data, 0x11223344);
+}
+
 class hierarchy_test : public peripheral
 {
 public:
@@ -631,3 +769,70 @@ TEST(registers, masking) {
     EXPECT_EQ(mock.transport(tx, SBI_NONE, VCML_AS_DEFAULT), 4);
     EXPECT_EQ(mock.array_reg[3], 8);
 }
+
+class mock_peripheral_decode : public peripheral
+{
+public:
+    vector<reg<u32>*> regs;
+
+    mock_peripheral_decode(const sc_module_name& nm): peripheral(nm), regs() {
+        // registers get created out of order and with holes in between
+        for (u64 i = 0; i < 64; i++) {
+            u64 idx = (i * 37) % 64;
+            string name = "reg" + std::to_string(idx);
+            regs.push_back(new reg<u32>(name, idx * 8, (u32)idx));
+        }
+
+        clk.stub(100 * MHz);
+        rst.stub();
+    }
+
+    virtual ~mock_peripheral_decode() {
+        for (auto* r : regs)
+            delete r;
+    }
+};
+
+TEST(registers, decoding) {
+    mock_peripheral_decode mock("decoding");
+    tlm_generic_payload tx;
+
+    for (u64 idx = 0; idx < 64; idx++) {
+        u32 data = ~0u;
+        tx_setup(tx, TLM_READ_COMMAND, idx * 8, &data, sizeof(data));
+        EXPECT_EQ(mock.transport(tx, SBI_NONE, VCML_AS_DEFAULT), 4);
+        EXPECT_EQ(data, idx);
+
+        tx_setup(tx, TLM_READ_COMMAND, idx * 8 + 4, &data, sizeof(data));
+        EXPECT_EQ(mock.transport(tx, SBI_NONE, VCML_AS_DEFAULT), 0);
+        EXPECT_EQ(tx.get_response_status(), TLM_ADDRESS_ERROR_RESPONSE);
+    }
+
+    // access spanning three registers and the holes in between
+    u32 data[5] = { ~0u, ~0u, ~0u, ~0u, ~0u };
+    tx_setup(tx, TLM_READ_COMMAND, 0x28, data, sizeof(data));
+    EXPECT_EQ(mock.transport(tx, SBI_NONE, VCML_AS_DEFAULT), 12);
+    EXPECT_EQ(data[0], 5);
+    EXPECT_EQ(data[2], 6);
+    EXPECT_EQ(data[4], 7);
+
+    // access starting in a hole and ending inside a register
+    u32 half = ~0u;
+    tx_setup(tx, TLM_READ_COMMAND, 0x2e, &half, sizeof(half));
+    EXPECT_EQ(mock.transport(tx, SBI_NONE, VCML_AS_DEFAULT), 2);
+    EXPECT_EQ(half, 0x0006ffffu);
+
+    reg_base* r6 = mock.regs[(6 * 45) % 64];
+    ASSERT_EQ(r6->get_address(), 0x30);
+    mock.remove_register(r6);
+
+    u32 val = ~0u;
+    tx_setup(tx, TLM_READ_COMMAND, 0x30, &val, sizeof(val));
+    EXPECT_EQ(mock.transport(tx, SBI_NONE, VCML_AS_DEFAULT), 0);
+    EXPECT_EQ(tx.get_response_status(), TLM_ADDRESS_ERROR_RESPONSE);
+    mock.add_register(r6);
+
+    tx_setup(tx, TLM_READ_COMMAND, 0x30, &val, sizeof(val));
+    EXPECT_EQ(mock.transport(tx, SBI_NONE, VCML_AS_DEFAULT), 4);
+    EXPECT_EQ(val, 6);
+}
@@ -0,0 +1,63 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "testing.h"
+
+class adaptive_quantum_test : public test_base
+{
+public:
+    generic::adaptive_quantum aq;
+
+    adaptive_quantum_test(const sc_module_name& nm):
+        test_base(nm), aq("aq") {
+        tlm_global_quantum::instance().set(sc_time(1, SC_US));
+    }
+
+    void wait_adjustment() {
+        size_t n = aq.adjustments();
+        while (aq.adjustments() == n)
+            wait(1, SC_MS);
+    }
+
+    virtual void run_test() override {
+        EXPECT_FALSE(aq.is_disabled());
+        EXPECT_EQ(aq.current(), aq.min_quantum.get());
+
+        // quantum doubles every ten quanta while nothing happens
+        wait(30, SC_MS);
+        EXPECT_EQ(aq.current(), aq.max_quantum.get());
+
+        // interrupts make it shrink again
+        report_quantum_activity(QUANTUM_ACTIVITY_IRQ);
+        wait_adjustment();
+        EXPECT_EQ(aq.current(), sc_time(250, SC_US));
+
+        // untracked activity is ignored
+        aq.track_irq = false;
+        report_quantum_activity(QUANTUM_ACTIVITY_IRQ);
+        wait_adjustment();
+        EXPECT_EQ(aq.current(), sc_time(500, SC_US));
+
+        // additive growth uses steps of min_quantum
+        aq.policy = "aimd";
+        aq.grow = 100.0;
+        wait_adjustment();
+        EXPECT_EQ(aq.current(), sc_time(600, SC_US));
+
+        report_quantum_activity(QUANTUM_ACTIVITY_SYNC);
+        wait_adjustment();
+        EXPECT_EQ(aq.current(), sc_time(150, SC_US));
+    }
+};
+
+TEST(generic_adaptive_quantum, adapt) {
+    adaptive_quantum_test test("test");
+    sc_core::sc_start();
+}
@@ -21,6 +21,8 @@ public:
     tlm_initiator_socket out2;
     tlm_target_socket in;
 
+    size_t out2_port;
+
     MOCK_METHOD(void, invalidate, (u64, u64));
 
     virtual void invalidate_direct_mem_ptr(tlm_initiator_socket& origin,
@@ -37,7 +39,8 @@ public:
         bus("bus"),
         out1("out1"),
         out2("out2"),
-        in("in") {
+        in("in"),
+        out2_port() {
         clk_bind(*this, "clk", mem1, "clk");
         clk_bind(*this, "clk", mem2, "clk");
         clk_bind(*this, "clk", bus, "clk");
@@ -47,7 +50,7 @@ public:
         gpio_bind(*this, "rst", bus, "rst");
 
         tlm_bind(bus, *this, "out1");
-        tlm_bind(bus, *this, "out2");
+        out2_port = bus.bind(out2);
 
         tlm_bind(bus, mem1, "in", 0x0000, 0x1fff, 0);
         tlm_bind(bus, mem2, "in", 0x2000, 0x3fff, 0);
@@ -161,6 +164,39 @@ public:
         EXPECT_OK(out2.readw<u32>(0xe800, data))
             << "cannot read from privately stubbed area";
 
+        // repeated accesses to the same page hit the route cache
+        u64 hits = bus.route_hits(out2_port);
+        u64 misses = bus.route_misses(out2_port);
+        EXPECT_OK(out2.readw<u32>(0x2000, data, SBI_NODMI));
+        EXPECT_OK(out2.readw<u32>(0x2004, data, SBI_NODMI));
+        EXPECT_EQ(bus.route_misses(out2_port), misses + 1);
+        EXPECT_EQ(bus.route_hits(out2_port), hits + 1);
+
+        EXPECT_CALL(*this, invalidate(0x2000, 0x3fff)).Times(2);
+        bus.unmap(1, 0x2000, 0x3fff);
+        EXPECT_AE(out1.readw<u32>(0x2000, data))
+            << "bus transaction went through for unmapped area";
+
+        // unmapping must flush routes instead of using stale ones
+        EXPECT_AE(out2.readw<u32>(0x2000, data, SBI_NODMI))
+            << "bus used stale route to unmapped area";
+        EXPECT_EQ(bus.route_misses(out2_port), misses + 2);
+        EXPECT_EQ(bus.route_hits(out2_port), hits + 1);
+
+        EXPECT_OK(out2.readw<u32>(0xc000, data))
+            << "unmapping removed unrelated private mapping";
+        EXPECT_EQ(data, 0x55555555)
+            << "unexpected data from memory at privately mapped area";
+
+        for (int i = 0; i < 4; i++) {
+            EXPECT_OK(out1.readw<u32>(0xe000 + i * 4, data))
+                << "cannot read from stubbed address area";
+            EXPECT_AE(out1.readw<u32>(0xe800 + i * 4, data))
+                << "unexpected data from privately stubbed area";
+            EXPECT_OK(out2.readw<u32>(0xe800 + i * 4, data))
+                << "cannot read from privately stubbed area";
+        }
+
         bus.execute("mmap", std::cout);
         std::cout << std::endl;
     }
@@ -61,8 +61,68 @@ public:
         ASSERT_CE(rom_port.writew(0x0, 0xfefefefe))
             << "read-only memory permitted write access after DMI invalidate";
 
+        std::stringstream ss;
+        EXPECT_TRUE(ram.execute("show", {}, ss));
+        EXPECT_NE(ss.str().find("hugetlb: off"), std::string::npos);
+        EXPECT_NE(ss.str().find("numa node: any"), std::string::npos);
+
+        // streaming to memory only performs the last beat
+        u32 beats[4] = { 0x11111111, 0x22222222, 0x33333333, 0x44444444 };
+        tlm_generic_payload tx;
+        tx_setup(tx, TLM_WRITE_COMMAND, 0x10, beats, sizeof(beats));
+        tx.set_streaming_width(sizeof(beats[0]));
+        EXPECT_EQ(ram_port.send(tx, SBI_NODMI), sizeof(beats));
+        EXPECT_TRUE(tx.is_response_ok());
+        EXPECT_EQ(*(u32*)(ram.data() + 0x10), 0x44444444);
+        EXPECT_EQ(*(u32*)(ram.data() + 0x14), 0);
+
+        // streaming from memory replicates the data into all beats
+        tx_setup(tx, TLM_READ_COMMAND, 0x10, beats, sizeof(beats));
+        tx.set_streaming_width(sizeof(beats[0]));
+        EXPECT_EQ(ram_port.send(tx, SBI_NODMI), sizeof(beats));
+        EXPECT_TRUE(tx.is_response_ok());
+        for (u32 beat : beats)
+            EXPECT_EQ(beat, 0x44444444);
+
         ASSERT_TRUE(is_aligned(ram.data(), VCML_ALIGN_2M))
             << "memory is not 21 bit aligned";
+
+        // vectored accesses, with scattered host buffers and a guest gap
+        u8 a[4] = { 1, 2, 3, 4 }, b[4] = { 5, 6, 7, 8 }, c[2] = { 9, 10 };
+        vector<tlm_iovec> iov = { { 0x100, a, 4 }, { 0x104, b, 4 },
+                                  { 0x200, c, 2 } };
+        unsigned int nbytes = 0;
+        for (const tlm_sbi& info : { SBI_NONE, SBI_NODMI, SBI_DEBUG }) {
+            ASSERT_OK(ram_port.writev(iov, info, &nbytes));
+            EXPECT_EQ(nbytes, 10);
+            EXPECT_EQ(memcmp(ram.data() + 0x100, a, 4), 0);
+            EXPECT_EQ(memcmp(ram.data() + 0x104, b, 4), 0);
+            EXPECT_EQ(memcmp(ram.data() + 0x200, c, 2), 0);
+
+            u8 x[4] = {}, y[4] = {}, z[2] = {};
+            vector<tlm_iovec> rdv = { { 0x100, x, 4 }, { 0x104, y, 4 },
+                                      { 0x200, z, 2 } };
+            ASSERT_OK(ram_port.readv(rdv, info, &nbytes));
+            EXPECT_EQ(nbytes, 10);
+            EXPECT_EQ(memcmp(x, a, 4), 0);
+            EXPECT_EQ(memcmp(y, b, 4), 0);
+            EXPECT_EQ(memcmp(z, c, 2), 0);
+            a[0]++;
+        }
+
+        vector<tlm_iovec> oob = { { 0xff0, a, 4 }, { 0x1000, b, 4 } };
+        EXPECT_AE(rom_port.readv(oob, SBI_NODMI));
+        EXPECT_CE(rom_port.writev(iov, SBI_NODMI));
+
+        // dirty tracking must revoke write DMI so all writes are seen
+        ram.track_dirty();
+        ASSERT_OK(ram_port.writew(0x2004, 0xabcdabcd));
+        vector<range> dirty = ram.fetch_dirty();
+        ASSERT_EQ(dirty.size(), 1);
+        EXPECT_EQ(dirty[0], range(0x2000, 0x2fff));
+        ASSERT_OK(ram_port.readw(0x2004, data));
+        EXPECT_EQ(data, 0xabcdabcd);
+        ram.track_dirty(false);
     }
 };
 
@@ -116,6 +116,42 @@ public:
         ASSERT_FALSE(irq1.read()) << "IRQ_TIMER_1 not cleared";
     }
 
+    void test_checkpoint() {
+        ASSERT_OK(out_mtimer.writew(0, ~0ul)) << "cannot write mtimecmp0";
+        ASSERT_OK(out_mtimer.writew(8, ~0ul)) << "cannot write mtimecmp1";
+        wait(SC_ZERO_TIME);
+        ASSERT_FALSE(irq_mtimer0.read()) << "IRQ_TIMER_0 not cleared";
+
+        u64 mtime, d = 100;
+        ASSERT_OK(out_mtimer.readw(0x7ff8, mtime)) << "cannot read mtime";
+        ASSERT_OK(out_mtimer.writew(0, mtime + d)) << "cannot write mtimecmp0";
+
+        checkpoint saved(false);
+        saved.write("aclint.ckpt");
+
+        // discard the pending compare and let its deadline pass
+        ASSERT_OK(out_mtimer.writew(0, ~0ul)) << "cannot write mtimecmp0";
+        wait(clock_cycles(2 * d));
+        wait(SC_ZERO_TIME);
+        ASSERT_FALSE(irq_mtimer0.read()) << "IRQ_TIMER_0 triggered";
+
+        checkpoint restored(true);
+        restored.read("aclint.ckpt");
+        restored.apply();
+        std::remove("aclint.ckpt");
+
+        // mtime continues from the checkpoint and the compare is re-armed
+        u64 now;
+        ASSERT_OK(out_mtimer.readw(0x7ff8, now)) << "cannot read mtime";
+        ASSERT_EQ(now, mtime) << "mtime not restored";
+        wait(clock_cycles(d / 2));
+        wait(SC_ZERO_TIME);
+        ASSERT_FALSE(irq_mtimer0.read()) << "IRQ_TIMER_0 triggered early";
+        wait(clock_cycles(d / 2));
+        wait(SC_ZERO_TIME);
+        ASSERT_TRUE(irq_mtimer0.read()) << "IRQ_TIMER_0 not restored";
+    }
+
     virtual void run_test() override {
         ASSERT_FALSE(irq_mtimer0.read()) << "IRQ_TIMER_0 not reset";
         ASSERT_FALSE(irq_mtimer1.read()) << "IRQ_TIMER_1 not reset";
@@ -132,6 +168,8 @@ public:
 
         test_swi(out_sswi, irq_ssw0, irq_ssw1);
         wait(SC_ZERO_TIME);
+
+        test_checkpoint();
     }
 };
 
@@ -36,6 +36,7 @@ public:
             TIMER1_LOAD = 0x00,
             TIMER1_VALUE = 0x04,
             TIMER1_CONTROL = 0x08,
+            TIMER1_INTCLR = 0x0c,
         };
 
         u32 val = 0x100;
@@ -81,6 +82,35 @@ public:
         val = 0;
         EXPECT_OK(out.readw(TIMER1_CONTROL, val)) << "cannot read CONTROL";
         EXPECT_EQ(val, 0x20) << "TIMER1_CONTROL did not reset";
+
+        // pending timeouts must survive a checkpoint restore
+        EXPECT_OK(out.writew(TIMER1_INTCLR, 1u)) << "cannot clear irq";
+        EXPECT_OK(out.writew(TIMER1_LOAD, 0x100u)) << "cannot set counter";
+        val = timers::sp804::timer::CONTROL_ENABLED |
+              timers::sp804::timer::CONTROL_IRQEN |
+              timers::sp804::timer::CONTROL_ONESHOT |
+              timers::sp804::timer::CONTROL_32BIT;
+        EXPECT_OK(out.writew(TIMER1_CONTROL, val)) << "cannot write CONTROL";
+        wait(clock_cycles(0x40));
+
+        checkpoint saved(false);
+        saved.write("sp804.ckpt");
+
+        // disabling the timer cancels the pending timeout
+        EXPECT_OK(out.writew(TIMER1_CONTROL, 0u)) << "cannot write CONTROL";
+        wait(clock_cycles(0x100));
+        EXPECT_FALSE(irq1) << "irq1 fired while disabled";
+
+        checkpoint restored(true);
+        restored.read("sp804.ckpt");
+        restored.apply();
+        std::remove("sp804.ckpt");
+
+        start = sc_time_stamp();
+        wait(irqc.default_event());
+        EXPECT_TRUE(irq1) << "irq1 did not fire after restore";
+        EXPECT_EQ(sc_time_stamp(), start + clock_cycles(0xc0))
+            << "restored interrupt did not fire at correct time";
     }
 };
 